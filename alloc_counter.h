@@ -0,0 +1,14 @@
+/*
+    AllocCounter
+    ------------
+    Counts heap allocations made through the global operator new, which alloc_counter.cpp
+    replaces with a counting version. The benchmarks read the counter around a run to report
+    the allocations per meal of the hot path, including the logger.
+*/
+
+#pragma once
+
+#include <cstdint>
+
+// Allocations made by all threads since the start of the process
+std::uint64_t heapAllocations();
@@ -0,0 +1,91 @@
+/*
+    AsyncSemaphore
+    --------------
+    Counting semaphore for suspended tasks instead of blocked threads.
+
+    acquireOrEnqueue() either takes a permit right away or links the caller's waiter node
+    into a FIFO list and returns; the caller then suspends instead of blocking its thread.
+    release() hands the permit straight to the oldest waiter and calls its wake(), which
+    reschedules the task already holding the permit. A chopstick is a semaphore with one permit.
+*/
+
+#pragma once
+
+#include "cache_line.h"
+
+#include <mutex>
+
+/*
+    Class: AsyncWaiter
+    ------------------
+    Intrusive waiter node. A waiter is linked into at most one semaphore at a time.
+*/
+class AsyncWaiter {
+public:
+    virtual ~AsyncWaiter() = default;
+
+    // Called by release() once the permit has been handed to this waiter
+    virtual void wake() = 0;
+
+private:
+    friend class AsyncSemaphore;
+    AsyncWaiter* nextWaiter_ = nullptr;
+};
+
+class alignas(CACHE_LINE_SIZE) AsyncSemaphore {
+public:
+    explicit AsyncSemaphore(const long permits = 1) : permits_(permits) {}
+
+    AsyncSemaphore(const AsyncSemaphore&) = delete;
+    AsyncSemaphore& operator=(const AsyncSemaphore&) = delete;
+
+    bool tryAcquire() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (permits_ == 0) {
+            return false;
+        }
+        permits_--;
+        return true;
+    }
+
+    // Takes a permit (true), or queues the waiter to be woken holding one later (false)
+    bool acquireOrEnqueue(AsyncWaiter& waiter) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (permits_ > 0) {
+            permits_--;
+            return true;
+        }
+        waiter.nextWaiter_ = nullptr;
+        if (tail_ == nullptr) {
+            head_ = &waiter;
+        } else {
+            tail_->nextWaiter_ = &waiter;
+        }
+        tail_ = &waiter;
+        return false;
+    }
+
+    void release() {
+        AsyncWaiter* next;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            next = head_;
+            if (next == nullptr) {
+                permits_++;
+                return;
+            }
+            head_ = next->nextWaiter_;
+            if (head_ == nullptr) {
+                tail_ = nullptr;
+            }
+        }
+        // Woken outside the lock: the waiter may immediately release or re-enqueue
+        next->wake();
+    }
+
+private:
+    std::mutex mutex_;
+    long permits_;
+    AsyncWaiter* head_ = nullptr;
+    AsyncWaiter* tail_ = nullptr;
+};
@@ -0,0 +1,500 @@
+#include "benchmark.h"
+#include "alloc_counter.h"
+#include "chopstick.h"
+#include "deadlock_detector.h"
+#include "discrete_event.h"
+#include "json_writer.h"
+#include "metrics_server.h"
+#include "philosopher.h"
+#include "resource_graph.h"
+#include "stats_reporter.h"
+#include "watchdog.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <latch>
+#include <memory>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Per-worker result slot, padded so that publishing results never causes false sharing
+struct alignas(CACHE_LINE_SIZE) WorkerCount {
+    std::uint64_t pairs = 0;
+};
+
+int resolveThreads(const Config& config) {
+    int threads = config.threads;
+    if (threads == 0) {
+        threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+    return std::min(threads, config.numPhilosophers);
+}
+
+/*
+    Function: measureLayout
+    -----------------------
+    Runs the interleaved acquire/release loop over a table of Chopstick and returns the
+    number of completed pick-up/put-down pairs per second.
+*/
+template <typename Chopstick>
+double measureLayout(const int numChopsticks, const int numThreads, const int durationMs) {
+    auto table = std::make_unique<Chopstick[]>(numChopsticks);
+    std::vector<WorkerCount> counts(numThreads);
+    std::atomic<bool> stop{false};
+    std::latch ready(numThreads + 1);
+
+    std::vector<std::thread> workers;
+    workers.reserve(numThreads);
+    for (int w = 0; w < numThreads; w++) {
+        workers.emplace_back([&, w] {
+            std::uint64_t pairs = 0;
+            ready.arrive_and_wait();
+            while (!stop.load(std::memory_order_relaxed)) {
+                for (int seat = w; seat < numChopsticks; seat += numThreads) {
+                    // Index order makes the benchmark deadlock-free for any interleaving
+                    const int first = std::min(seat, (seat + 1) % numChopsticks);
+                    const int second = std::max(seat, (seat + 1) % numChopsticks);
+                    table[first].acquire();
+                    table[second].acquire();
+                    table[second].release();
+                    table[first].release();
+                    pairs++;
+                }
+            }
+            counts[w].pairs = pairs;
+        });
+    }
+
+    ready.arrive_and_wait();
+    const auto start = std::chrono::steady_clock::now();
+    std::this_thread::sleep_for(std::chrono::milliseconds(durationMs));
+    stop.store(true, std::memory_order_relaxed);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::uint64_t total = 0;
+    for (const auto& count : counts) {
+        total += count.pairs;
+    }
+    return static_cast<double>(total) / elapsed.count();
+}
+
+/*
+    Function: graphWorker
+    ---------------------
+    One worker of the resource graph: thinks, takes every resource of its set in ascending
+    order, eats and puts them down, until the stop or the meal limit.
+*/
+template <typename Chopstick>
+void graphWorker(const std::stop_token& stop, const Config& config, const ResourceGraph& graph, Chopstick* resources,
+                 PhilosopherStats& stats, std::atomic<int>& finished, std::latch& ready, const int worker) {
+    const std::span<const int> needed = graph.resourcesOf(worker);
+    std::mt19937_64 rng(config.seed * 0x9e3779b97f4a7c15ULL + static_cast<std::uint64_t>(worker));
+    ready.arrive_and_wait();
+    while (!stop.stop_requested()) {
+        config.think.apply(rng, stop);
+        if (stop.stop_requested()) {
+            break;
+        }
+
+        const auto hungrySince = startHungryWait(stats);
+        std::size_t held = 0;
+        for (; held < needed.size(); held++) {
+            Chopstick& resource = resources[needed[held]];
+            if (!resource.tryAcquire()) {
+                bump(stats.failedTryAcquires);
+                if (!resource.acquire(stop)) {
+                    break;
+                }
+            }
+            if (held == 0) {
+                stats.chopsticksHeld = 1;
+                stats.firstPickedUp = std::chrono::steady_clock::now();
+            }
+        }
+        if (held < needed.size()) {
+            while (held > 0) {
+                resources[needed[--held]].release();
+            }
+            stats.chopsticksHeld = 0;
+            stats.hungrySinceNs.store(0, std::memory_order_relaxed);
+            break;
+        }
+        recordAcquisition(stats, hungrySince, std::chrono::steady_clock::now());
+
+        config.eat.apply(rng, stop);
+        for (auto resource = needed.rbegin(); resource != needed.rend(); ++resource) {
+            resources[*resource].release();
+        }
+
+        bump(stats.meals);
+        if (config.meals != 0 && stats.meals.load(std::memory_order_relaxed) >= static_cast<std::uint64_t>(config.meals)) {
+            finished.fetch_add(1, std::memory_order_release);
+            break;
+        }
+    }
+}
+
+/*
+    Function: runGraph
+    ------------------
+    Runs one thread per worker of the graph over a table of Chopstick resources and returns
+    the elapsed time.
+*/
+template <typename Chopstick>
+std::chrono::nanoseconds runGraph(const Config& config, const ResourceGraph& graph, PhilosopherStats* stats) {
+    auto resources = std::make_unique<Chopstick[]>(graph.numResources());
+    std::atomic<int> finished{0};
+
+    // Thousands of running workers would starve the thread still creating the rest, so all
+    // start together once every thread exists
+    std::latch ready(graph.numWorkers() + 1);
+    std::vector<std::jthread> workers;
+    workers.reserve(graph.numWorkers());
+    for (int w = 0; w < graph.numWorkers(); w++) {
+        workers.emplace_back([&, w](const std::stop_token stop) {
+            graphWorker(stop, config, graph, resources.get(), stats[w], finished, ready, w);
+        });
+    }
+    ready.arrive_and_wait();
+    const auto start = std::chrono::steady_clock::now();
+    waitForRunEnd(finished, graph.numWorkers(), start, std::chrono::milliseconds(config.durationMs));
+
+    // Stop everyone, then join: a worker blocked on a resource gives up its wait
+    for (auto& worker : workers) {
+        worker.request_stop();
+    }
+    workers.clear();
+    return std::chrono::steady_clock::now() - start;
+}
+
+/*
+    Function: writeWatchdog
+    -----------------------
+    Emits the watchdog's SLO and fairness alerts as a JSON object.
+*/
+void writeWatchdog(JsonWriter& json, const Watchdog& watchdog) {
+    const auto summarize = [&](const char* name, const std::vector<std::uint64_t>& alerts) {
+        std::uint64_t total = 0;
+        int philosophers = 0;
+        for (const std::uint64_t count : alerts) {
+            total += count;
+            philosophers += count > 0 ? 1 : 0;
+        }
+        json.key(name).beginObject()
+            .field("alerts", total)
+            .field("philosophers", philosophers)
+            .endObject();
+    };
+    json.key("watchdog").beginObject()
+        .field("wait_slo_ms", static_cast<std::int64_t>(watchdog.waitSlo().count()))
+        .field("fairness_threshold", watchdog.fairnessThreshold())
+        .field("longest_wait_seen_ns", watchdog.longestWaitNs());
+    summarize("wait_slo", watchdog.sloViolations());
+    summarize("fairness", watchdog.fairnessAlerts());
+    json.endObject();
+}
+
+// busy_fraction near 1 means the arbiter thread is saturated and requests queue up behind it
+void writeArbiter(JsonWriter& json, const ArbiterStats& arbiter) {
+    const double lifetimeNs = static_cast<double>(arbiter.lifetime.count());
+    json.key("arbiter").beginObject()
+        .field("messages", arbiter.messages)
+        .field("grants", arbiter.grants)
+        .field("batches", arbiter.batches)
+        .field("mean_batch",
+               arbiter.batches == 0 ? 0.0 : static_cast<double>(arbiter.messages) / static_cast<double>(arbiter.batches))
+        .field("max_batch", arbiter.maxBatch)
+        .field("max_pending", arbiter.maxPending)
+        .field("parks", arbiter.parks)
+        .field("busy_fraction", lifetimeNs == 0.0 ? 0.0 : static_cast<double>(arbiter.busy.count()) / lifetimeNs)
+        .endObject();
+}
+
+/*
+    Function: writePerf
+    -------------------
+    Emits the summed counters of the philosopher threads as a JSON object: per counter the
+    total and the value per meal, or why it was unavailable, then the part of the acquire
+    counter spent inside acquire().
+*/
+void writePerf(JsonWriter& json, const PerfCollector& perf, const std::uint64_t meals, const std::uint64_t acquisitions) {
+    const auto per = [](const std::uint64_t value, const std::uint64_t count) {
+        return count == 0 ? 0.0 : static_cast<double>(value) / static_cast<double>(count);
+    };
+    json.key("perf_counters").beginObject()
+        .field("threads", perf.threads());
+    for (int i = 0; i < NUM_PERF_COUNTERS; i++) {
+        const auto counter = static_cast<PerfCounter>(i);
+        json.key(perfCounterName(counter)).beginObject();
+        if (perf.available(counter)) {
+            json.field("total", perf.total(counter))
+                .field("per_meal", per(perf.total(counter), meals))
+                .field("user_only", perf.userOnly(counter));
+        } else {
+            json.field("unavailable", perf.unavailableReason(counter));
+        }
+        json.endObject();
+    }
+    if (const auto counter = perf.acquireCounter()) {
+        json.key("acquire").beginObject()
+            .field("counter", perfCounterName(*counter))
+            .field("total", perf.acquireTotal())
+            .field("per_acquisition", per(perf.acquireTotal(), acquisitions))
+            .field("share", per(perf.acquireTotal(), perf.total(*counter)))
+            .endObject();
+    }
+    json.endObject();
+}
+
+}  // namespace
+
+int runBenchmark(const Config& config) {
+    DiningTable table(config);
+    std::optional<MetricsServer> metrics;
+    if (config.metrics.enabled()) {
+        try {
+            metrics.emplace(table, config.metrics);
+        } catch (const std::runtime_error& e) {
+            std::cerr << "Error: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+    std::optional<StatsReporter> reporter(std::in_place, table, config.statsIntervalMs);
+    Watchdog watchdog(table, std::chrono::milliseconds(config.waitSloMs), config.fairnessThreshold);
+    DeadlockDetector detector(table, std::chrono::milliseconds(config.deadlockCheckMs));
+
+    const std::uint64_t allocationsBefore = heapAllocations();
+    const RunResult run = runTable(table, config);
+    const std::uint64_t allocations = heapAllocations() - allocationsBefore;
+    const std::chrono::duration<double> elapsed = run.elapsed;
+    const std::optional<ArbiterStats> arbiter = table.strategy ? table.strategy->arbiterStats() : std::nullopt;
+    watchdog.stop();
+    detector.stop();
+    reporter.reset();
+
+    StatsSnapshot totals;
+    LatencyHistogram hungryWait;
+    for (int i = 0; i < table.numPhilosophers; i++) {
+        totals.add(table.stats[i]);
+        hungryWait.merge(table.stats[i].hungryWait);
+    }
+    const std::uint64_t totalMeals = totals.meals;
+
+    JsonWriter json(std::cout);
+    json.beginObject()
+        .field("strategy", strategyName(config.strategy))
+        .field("chopstick", chopstickName(config.chopstick))
+        .field("executor", executorName(config.executor))
+        .field("placement", placementName(config.placement))
+        .field("numa_nodes", table.placement.numNodes())
+        .field("pinned_threads", table.pinned.load())
+        .field("workers", run.workers)
+        .field("steals", run.steals)
+        .field("philosophers", table.numPhilosophers)
+        .field("think", config.think.describe())
+        .field("eat", config.eat.describe())
+        .field("courses", config.courses.describe())
+        .field("static_table", table.staticTable)
+        .field("elapsed_s", elapsed.count())
+        .field("total_meals", totalMeals)
+        .field("meals_per_sec", static_cast<double>(totalMeals) / elapsed.count())
+        .field("courses_per_acquisition",
+               hungryWait.count() == 0 ? 0.0 : static_cast<double>(totalMeals) / static_cast<double>(hungryWait.count()));
+    json.key("hungry_wait_ns");
+    writeLatency(json, hungryWait);
+    json.field("half_held_ns", totals.halfHeldNs)
+        .field("failed_try_acquires", totals.failedTryAcquires)
+        .field("backoffs", totals.backoffs);
+    if (config.strategy == StrategyKind::Backoff) {
+        json.field("backoff", config.backoff.describe());
+    }
+    json.field("heap_allocations", allocations)
+        .field("allocations_per_meal", totalMeals == 0 ? 0.0 : static_cast<double>(allocations) / static_cast<double>(totalMeals));
+    json.key("context_switches").beginObject()
+        .field("voluntary", run.voluntaryContextSwitches)
+        .field("involuntary", run.involuntaryContextSwitches)
+        .endObject();
+
+    std::vector<std::uint64_t> meals(table.numPhilosophers);
+    for (int i = 0; i < table.numPhilosophers; i++) {
+        meals[i] = table.stats[i].meals.load(std::memory_order_relaxed);
+    }
+    const auto [fewest, most] = std::minmax_element(meals.begin(), meals.end());
+    json.key("fairness").beginObject()
+        .field("jain_meals", jainFairness(meals))
+        .field("min_meals", *fewest)
+        .field("max_meals", *most)
+        .endObject();
+    if (watchdog.enabled()) {
+        writeWatchdog(json, watchdog);
+    }
+    if (arbiter) {
+        writeArbiter(json, *arbiter);
+    }
+    if (table.perf) {
+        writePerf(json, *table.perf, totalMeals, hungryWait.count());
+    }
+    if (detector.enabled()) {
+        json.key("deadlock_detector").beginObject()
+            .field("interval_ms", static_cast<std::int64_t>(detector.interval().count()))
+            .field("deadlocks", detector.deadlocks());
+        json.key("first_cycle").beginArray();
+        for (const int philosopher : detector.firstCycle()) {
+            json.value(philosopher);
+        }
+        json.endArray();
+        json.endObject();
+    }
+    json.key("meals_per_philosopher").beginArray();
+    for (const std::uint64_t count : meals) {
+        json.value(count);
+    }
+    json.endArray();
+    json.endObject();
+    return 0;
+}
+
+int runLayoutBenchmark(const Config& config) {
+    const int threads = resolveThreads(config);
+
+    std::printf("Layout benchmark: %d chopsticks, %d threads, %d ms per layout\n",
+                config.numPhilosophers, threads, config.durationMs);
+    std::printf("%-8s %16s %14s %10s\n", "layout", "bytes/chopstick", "pairs/s", "ns/pair");
+
+    const double packed = measureLayout<PackedChopstick>(config.numPhilosophers, threads, config.durationMs);
+    std::printf("%-8s %16zu %14.0f %10.1f\n", "packed", sizeof(PackedChopstick), packed, 1e9 * threads / packed);
+
+    const double padded = measureLayout<PaddedChopstick>(config.numPhilosophers, threads, config.durationMs);
+    std::printf("%-8s %16zu %14.0f %10.1f\n", "padded", sizeof(PaddedChopstick), padded, 1e9 * threads / padded);
+
+    std::printf("padded/packed throughput: %.2fx\n", padded / packed);
+    return 0;
+}
+
+int runGraphBenchmark(const Config& config) {
+    std::optional<ResourceGraph> loaded;
+    try {
+        loaded = ResourceGraph::build(config.topology, config.numPhilosophers, config.seed);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    const ResourceGraph& graph = *loaded;
+    const auto stats = std::make_unique<PhilosopherStats[]>(graph.numWorkers());
+
+    std::chrono::duration<double> elapsed{};
+    switch (config.chopstick) {
+        case ChopstickKind::Semaphore:
+            elapsed = runGraph<PaddedChopstick>(config, graph, stats.get());
+            break;
+        case ChopstickKind::SpinPark:
+            elapsed = runGraph<SpinParkChopstick>(config, graph, stats.get());
+            break;
+        case ChopstickKind::Ticket:
+            elapsed = runGraph<TicketChopstick>(config, graph, stats.get());
+            break;
+    }
+
+    StatsSnapshot totals;
+    LatencyHistogram hungryWait;
+    std::vector<std::uint64_t> meals(graph.numWorkers());
+    for (int i = 0; i < graph.numWorkers(); i++) {
+        totals.add(stats[i]);
+        hungryWait.merge(stats[i].hungryWait);
+        meals[i] = stats[i].meals.load(std::memory_order_relaxed);
+    }
+
+    JsonWriter json(std::cout);
+    json.beginObject()
+        .field("topology", config.topology.describe())
+        .field("chopstick", chopstickName(config.chopstick))
+        .field("workers", graph.numWorkers())
+        .field("resources", graph.numResources())
+        .field("max_resources_per_worker", graph.maxResourcesPerWorker())
+        .field("max_workers_per_resource", graph.maxWorkersPerResource())
+        .field("think", config.think.describe())
+        .field("eat", config.eat.describe())
+        .field("elapsed_s", elapsed.count())
+        .field("total_meals", totals.meals)
+        .field("meals_per_sec", static_cast<double>(totals.meals) / elapsed.count());
+    json.key("hungry_wait_ns");
+    writeLatency(json, hungryWait);
+    json.field("half_held_ns", totals.halfHeldNs)
+        .field("failed_try_acquires", totals.failedTryAcquires);
+    const auto [fewest, most] = std::minmax_element(meals.begin(), meals.end());
+    json.key("fairness").beginObject()
+        .field("jain_meals", jainFairness(meals))
+        .field("min_meals", *fewest)
+        .field("max_meals", *most)
+        .endObject();
+    json.key("meals_per_worker").beginArray();
+    for (const std::uint64_t count : meals) {
+        json.value(count);
+    }
+    json.endArray();
+    json.endObject();
+    return 0;
+}
+
+int runDiscreteEventBenchmark(const Config& config) {
+    DiningTable table(config);
+    DiscreteEventSimulation simulation(table);
+
+    const auto start = std::chrono::steady_clock::now();
+    simulation.run(std::chrono::milliseconds(config.durationMs));
+    const std::chrono::duration<double> wall = std::chrono::steady_clock::now() - start;
+    const std::chrono::duration<double> simulated = simulation.now();
+
+    StatsSnapshot totals;
+    LatencyHistogram hungryWait;
+    std::vector<std::uint64_t> meals(table.numPhilosophers);
+    for (int i = 0; i < table.numPhilosophers; i++) {
+        totals.add(table.stats[i]);
+        hungryWait.merge(table.stats[i].hungryWait);
+        meals[i] = table.stats[i].meals.load(std::memory_order_relaxed);
+    }
+    const auto [fewest, most] = std::minmax_element(meals.begin(), meals.end());
+
+    JsonWriter json(std::cout);
+    json.beginObject()
+        .field("strategy", strategyName(config.strategy))
+        .field("philosophers", table.numPhilosophers)
+        .field("think", config.think.describe())
+        .field("eat", config.eat.describe())
+        .field("seed", config.seed)
+        .field("virtual_s", simulated.count())
+        .field("wall_s", wall.count())
+        .field("events", simulation.events())
+        .field("events_per_wall_sec", static_cast<double>(simulation.events()) / wall.count())
+        .field("total_meals", totals.meals)
+        .field("meals_per_virtual_sec", static_cast<double>(totals.meals) / simulated.count())
+        .field("meals_per_wall_sec", static_cast<double>(totals.meals) / wall.count());
+    json.key("hungry_wait_ns");
+    writeLatency(json, hungryWait);
+    json.field("half_held_ns", totals.halfHeldNs)
+        .field("failed_try_acquires", totals.failedTryAcquires);
+    json.key("fairness").beginObject()
+        .field("jain_meals", jainFairness(meals))
+        .field("min_meals", *fewest)
+        .field("max_meals", *most)
+        .endObject();
+    json.key("meals_per_philosopher").beginArray();
+    for (const std::uint64_t count : meals) {
+        json.value(count);
+    }
+    json.endArray();
+    json.endObject();
+    return 0;
+}
@@ -0,0 +1,62 @@
+/*
+    Benchmark
+    ---------
+    Measurement modes that run instead of the endless simulation.
+*/
+
+#pragma once
+
+#include "config.h"
+
+/*
+    Function: runBenchmark
+    ----------------------
+    Runs the philosopher workers with the configured strategy and think/eat times, for
+    config.durationMs or until every philosopher has eaten config.meals meals, and prints a
+    JSON report to stdout:
+    - total meals and meals per second,
+    - meals per philosopher,
+    - p50/p99/p999/max of the time between "hungry" and holding both chopsticks.
+
+    Returns the process exit code.
+*/
+int runBenchmark(const Config& config);
+
+/*
+    Function: runLayoutBenchmark
+    ----------------------------
+    Compares acquire/release throughput of the padded and packed chopstick layouts.
+
+    Worker threads take seats in an interleaved pattern (worker w owns seats w, w + T, ...),
+    so neighbouring seats, and therefore adjacent chopsticks, are driven from different cores.
+    Each seat picks up and puts down both of its chopsticks in index order, without thinking
+    or eating, for config.durationMs per layout.
+
+    Returns the process exit code.
+*/
+int runLayoutBenchmark(const Config& config);
+
+/*
+    Function: runDiscreteEventBenchmark
+    -----------------------------------
+    Runs the discrete-event simulation (see discrete_event.h) for config.durationMs of virtual
+    time or until every philosopher has eaten config.meals meals, and prints a JSON report:
+    throughput in virtual and wall time, the virtual hungry-wait distribution, and the
+    fairness of the meal shares (Jain's index, fewest and most meals).
+
+    Returns the process exit code.
+*/
+int runDiscreteEventBenchmark(const Config& config);
+
+/*
+    Function: runGraphBenchmark
+    ---------------------------
+    Runs one thread per worker of the configured resource graph (see resource_graph.h). Each
+    worker thinks, takes all of its resources in ascending order, eats and puts them down,
+    for config.durationMs or config.meals meals. Prints a JSON report with the graph's size,
+    throughput, the hungry-wait distribution (becoming hungry until the whole set is held)
+    and the fairness of the meals.
+
+    Returns the process exit code.
+*/
+int runGraphBenchmark(const Config& config);
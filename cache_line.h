@@ -0,0 +1,25 @@
+/*
+    CACHE_LINE_SIZE
+    ---------------
+    Size of the block that two cores writing independent data must not share
+    (std::hardware_destructive_interference_size where the library provides it).
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+#if defined(__cpp_lib_hardware_interference_size)
+// GCC warns that the value depends on -mtune; it is fixed per build, which is all we need
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Winterference-size"
+#endif
+inline constexpr std::size_t CACHE_LINE_SIZE = std::hardware_destructive_interference_size;
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#else
+inline constexpr std::size_t CACHE_LINE_SIZE = 64;
+#endif
@@ -0,0 +1,275 @@
+/*
+    Chopstick
+    ---------
+    Chopstick primitives. Every primitive provides acquire(), tryAcquire(), tryAcquireFor()
+    and release(), so strategies can be instantiated for any of them. acquire(stop) is the
+    cancellable form: it returns false, without the chopstick, once a stop has been requested
+    on the token. tryAcquireFor(timeout) gives up, without the chopstick, after the timeout.
+
+    - PaddedChopstick: binary semaphore that owns a full destructive-interference block
+      (cache line), so philosophers working on different chopsticks never contend for the
+      same line. The default primitive.
+    - PackedChopstick: plain semaphores laid out back to back, as in the original
+      chopsticks[] array. Kept for the layout benchmark.
+    - SpinParkChopstick: atomic lock word that spins with bounded exponential backoff before
+      parking the thread with std::atomic::wait. Short holds are handed over without a
+      system call.
+    - TicketChopstick: FIFO ticket lock, spinning then parking on the serving counter. Waiters
+      are served in arrival order, which bounds how often a neighbour can win in a row.
+*/
+
+#pragma once
+
+#include "cache_line.h"
+#include "cpu_relax.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <semaphore>
+#include <stop_token>
+#include <thread>
+
+enum class ChopstickKind {
+    Semaphore,
+    SpinPark,
+    Ticket
+};
+
+// Command-line name of a chopstick primitive
+inline const char* chopstickName(const ChopstickKind kind) {
+    switch (kind) {
+        case ChopstickKind::Semaphore:
+            return "semaphore";
+        case ChopstickKind::SpinPark:
+            return "spin-park";
+        case ChopstickKind::Ticket:
+            return "ticket";
+    }
+    return "unknown";
+}
+
+// How often a thread blocked on a semaphore re-checks its stop token
+inline constexpr std::chrono::milliseconds STOP_POLL_INTERVAL{1};
+
+/*
+    Function: acquireUnlessStopped
+    ------------------------------
+    Blocks on a semaphore until it is acquired (true) or a stop is requested (false). A release
+    still wakes the waiter immediately; the poll interval only bounds the reaction to a stop.
+*/
+template <typename Semaphore>
+bool acquireUnlessStopped(Semaphore& semaphore, const std::stop_token& stop) {
+    while (!semaphore.try_acquire_for(STOP_POLL_INTERVAL)) {
+        if (stop.stop_requested()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+    Function: spinThenYield
+    -----------------------
+    tryAcquireFor() of the primitives that cannot wait with a timeout: retries tryAcquire()
+    with a short exponential spin, then yielding the CPU, until the timeout has passed.
+*/
+template <typename Chopstick>
+bool spinThenYield(Chopstick& chopstick, const std::chrono::nanoseconds timeout) {
+    constexpr int MAX_SPIN = 64;
+    for (int backoff = 1; backoff <= MAX_SPIN; backoff *= 2) {
+        if (chopstick.tryAcquire()) {
+            return true;
+        }
+        for (int i = 0; i < backoff; i++) {
+            cpuRelax();
+        }
+    }
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!chopstick.tryAcquire()) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+struct alignas(CACHE_LINE_SIZE) PaddedChopstick {
+    std::binary_semaphore semaphore{1};  // Initialized to 1 (available)
+
+    void acquire() { semaphore.acquire(); }
+    bool acquire(const std::stop_token& stop) { return acquireUnlessStopped(semaphore, stop); }
+    bool tryAcquire() { return semaphore.try_acquire(); }
+    bool tryAcquireFor(const std::chrono::nanoseconds timeout) { return semaphore.try_acquire_for(timeout); }
+    void release() { semaphore.release(); }
+};
+
+struct PackedChopstick {
+    std::binary_semaphore semaphore{1};  // Initialized to 1 (available)
+
+    void acquire() { semaphore.acquire(); }
+    bool acquire(const std::stop_token& stop) { return acquireUnlessStopped(semaphore, stop); }
+    bool tryAcquire() { return semaphore.try_acquire(); }
+    bool tryAcquireFor(const std::chrono::nanoseconds timeout) { return semaphore.try_acquire_for(timeout); }
+    void release() { semaphore.release(); }
+};
+
+static_assert(sizeof(PaddedChopstick) == CACHE_LINE_SIZE, "padded chopstick must fill one cache line");
+
+/*
+    Class: SpinParkChopstick
+    ------------------------
+    Lock word with the states FREE, HELD, HELD_PARKED (held, and a waiter may be parked) and
+    HELD_WAKE (held, parked waiters asked to re-check their stop token).
+    - acquire() first spins, doubling the number of cpuRelax() hints between attempts up to
+      MAX_BACKOFF, and only then marks the word HELD_PARKED and waits on it.
+    - release() stores FREE and issues a notify only if a waiter may be parked, so an
+      uncontended or spin-resolved handoff costs one atomic exchange.
+    - A stop request moves HELD_PARKED to HELD_WAKE so std::atomic::wait returns.
+    - std::atomic::wait has no timeout, so tryAcquireFor() yields between attempts once the
+      spin is over instead of parking.
+*/
+class alignas(CACHE_LINE_SIZE) SpinParkChopstick {
+public:
+    static constexpr int MAX_BACKOFF = 64;  // cpuRelax() hints in the last spin round
+
+    void acquire() {
+        acquire(std::stop_token{});
+    }
+
+    bool acquire(const std::stop_token& stop) {
+        for (int backoff = 1; backoff <= MAX_BACKOFF; backoff *= 2) {
+            if (tryAcquire()) {
+                return true;
+            }
+            for (int i = 0; i < backoff; i++) {
+                cpuRelax();
+            }
+        }
+
+        // Park. Claiming the word as HELD_PARKED keeps the releasing thread's notify armed.
+        std::stop_callback wakeOnStop(stop, [this] { wakeParked(); });
+        std::uint32_t previous = state_.exchange(HELD_PARKED, std::memory_order_acquire);
+        while (previous != FREE) {
+            if (stop.stop_requested()) {
+                return false;
+            }
+            state_.wait(HELD_PARKED, std::memory_order_relaxed);
+            previous = state_.exchange(HELD_PARKED, std::memory_order_acquire);
+        }
+        return true;
+    }
+
+    bool tryAcquireFor(const std::chrono::nanoseconds timeout) {
+        return spinThenYield(*this, timeout);
+    }
+
+    bool tryAcquire() {
+        std::uint32_t expected = FREE;
+        // Test before the CAS so spinning waiters only read the line
+        return state_.load(std::memory_order_relaxed) == FREE &&
+               state_.compare_exchange_strong(expected, HELD, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    void release() {
+        if (state_.exchange(FREE, std::memory_order_release) >= HELD_PARKED) {
+            state_.notify_one();
+        }
+    }
+
+private:
+    static constexpr std::uint32_t FREE = 0;
+    static constexpr std::uint32_t HELD = 1;
+    static constexpr std::uint32_t HELD_PARKED = 2;
+    static constexpr std::uint32_t HELD_WAKE = 3;
+
+    void wakeParked() {
+        std::uint32_t expected = HELD_PARKED;
+        state_.compare_exchange_strong(expected, HELD_WAKE, std::memory_order_relaxed);
+        state_.notify_all();
+    }
+
+    std::atomic<std::uint32_t> state_{FREE};
+};
+
+static_assert(sizeof(SpinParkChopstick) == CACHE_LINE_SIZE, "spin-park chopstick must fill one cache line");
+
+/*
+    Class: TicketChopstick
+    ----------------------
+    Ticket lock: acquire() draws the next ticket and waits until the serving counter reaches
+    it, so the chopstick goes to its waiters strictly in arrival order, unlike a semaphore,
+    where either side may win every time. A chopstick has at most two contenders, so plain
+    spinning on the shared counter costs as little as an MCS queue would.
+    - Waiting spins with the backoff of SpinParkChopstick, then parks on the serving counter.
+      release() only notifies when a waiter announced itself in parked_.
+    - tryAcquire() draws a ticket only if it is served at once, and tryAcquireFor() retries
+      it until the timeout, so a timed-out attempt never leaves a ticket behind.
+    - A drawn ticket cannot be handed back without stalling the waiters behind it, so a
+      stopped waiter still waits for its turn and passes the chopstick straight on. That
+      turn only comes if the holder can put the chopstick down, i.e. is not itself waiting
+      in a deadlock, which is why parseArgs() rejects the naive strategy on ticket chopsticks.
+*/
+class alignas(CACHE_LINE_SIZE) TicketChopstick {
+public:
+    static constexpr int MAX_BACKOFF = 64;
+
+    void acquire() {
+        waitForTurn(nextTicket_.fetch_add(1, std::memory_order_relaxed));
+    }
+
+    bool acquire(const std::stop_token& stop) {
+        acquire();
+        if (stop.stop_requested()) {
+            release();
+            return false;
+        }
+        return true;
+    }
+
+    bool tryAcquireFor(const std::chrono::nanoseconds timeout) {
+        return spinThenYield(*this, timeout);
+    }
+
+    bool tryAcquire() {
+        std::uint32_t serving = nowServing_.load(std::memory_order_relaxed);
+        return nextTicket_.compare_exchange_strong(serving, serving + 1, std::memory_order_acquire,
+                                                   std::memory_order_relaxed);
+    }
+
+    void release() {
+        nowServing_.fetch_add(1, std::memory_order_seq_cst);
+        // Pairs with the announcement in waitForTurn(): either the waiter sees the new
+        // value, or the notify here sees the waiter
+        if (parked_.load(std::memory_order_seq_cst) != 0) {
+            nowServing_.notify_all();
+        }
+    }
+
+private:
+    void waitForTurn(const std::uint32_t ticket) {
+        for (int backoff = 1; backoff <= MAX_BACKOFF; backoff *= 2) {
+            if (nowServing_.load(std::memory_order_acquire) == ticket) {
+                return;
+            }
+            for (int i = 0; i < backoff; i++) {
+                cpuRelax();
+            }
+        }
+
+        parked_.fetch_add(1, std::memory_order_seq_cst);
+        for (std::uint32_t serving = nowServing_.load(std::memory_order_seq_cst); serving != ticket;
+             serving = nowServing_.load(std::memory_order_seq_cst)) {
+            nowServing_.wait(serving, std::memory_order_seq_cst);
+        }
+        parked_.fetch_sub(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+    }
+
+    std::atomic<std::uint32_t> nextTicket_{0};
+    std::atomic<std::uint32_t> nowServing_{0};
+    std::atomic<std::uint32_t> parked_{0};  // Waiters that may be blocked in wait()
+};
+
+static_assert(sizeof(TicketChopstick) == CACHE_LINE_SIZE, "ticket chopstick must fill one cache line");
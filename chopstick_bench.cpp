@@ -0,0 +1,188 @@
+/*
+    chopstick-bench
+    ---------------
+    Google Benchmark microbenchmarks of the chopstick primitives in isolation, without
+    philosophers, strategies or logging, so a regression in a primitive shows up on its own.
+
+    Usage: chopstick-bench [--benchmark_filter=REGEX] [other Google Benchmark flags]
+
+    Every primitive runs three benchmarks:
+    - Uncontended: one thread picks up and puts down a chopstick nobody else touches.
+    - PingPong:    two threads pick up and put down the same chopstick, so nearly every
+                   pickup is a handoff from the other thread.
+    - Ring:        N threads around a ring of N chopsticks, each taking its two neighbours
+                   lower-numbered first (as the hierarchy strategy does), swept from 1 thread
+                   to all cores.
+    Primitives: the padded std::binary_semaphore, the spin-then-park lock word, the FIFO
+    ticket lock, and the CAS fork bitmap, whose single pickup is a pair of one fork. Items per
+    second count pickups (Uncontended, PingPong) or meals (Ring).
+
+    Meal benchmarks measure what a philosopher pays per meal for the strategy itself: one
+    thread acquires and releases the seats of an N-seat asymmetric table in turn, once through
+    the AcquisitionStrategy interface of makeStrategy() (dynamic) and once on the StaticTable
+    specialized for N (static, see static_table.h). Both do the same per-pickup accounting.
+*/
+
+#include "chopstick.h"
+#include "fork_bitmap.h"
+#include "logger.h"
+#include "metrics.h"
+#include "numa_array.h"
+#include "static_table.h"
+#include "strategy.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <memory>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Ring threads at most, and thus ring chopsticks
+int maxThreads() {
+    return static_cast<int>(std::max(1U, std::thread::hardware_concurrency()));
+}
+
+// A table of one chopstick primitive
+template <typename Chopstick>
+class ChopstickTable {
+public:
+    explicit ChopstickTable(const int size) : chopsticks_(size) {}
+
+    void acquire(const int i) { chopsticks_[i].acquire(); }
+    void release(const int i) { chopsticks_[i].release(); }
+
+    void acquirePair(const int a, const int b) {
+        chopsticks_[std::min(a, b)].acquire();
+        chopsticks_[std::max(a, b)].acquire();
+    }
+
+    void releasePair(const int a, const int b) {
+        chopsticks_[a].release();
+        chopsticks_[b].release();
+    }
+
+private:
+    NumaArray<Chopstick> chopsticks_;
+};
+
+// The fork bitmap behind the same interface; a single fork is the pair (i, i)
+class BitmapTable {
+public:
+    explicit BitmapTable(const int size) : forks_(size) {}
+
+    void acquire(const int i) { forks_.acquirePair(i, i); }
+    void release(const int i) { forks_.releasePair(i, i); }
+    void acquirePair(const int a, const int b) { forks_.acquirePair(a, b); }
+    void releasePair(const int a, const int b) { forks_.releasePair(a, b); }
+
+private:
+    ForkBitmap forks_;
+};
+
+// Shared by the threads of a benchmark; every run leaves all chopsticks free
+template <typename Table>
+Table& sharedTable() {
+    static Table table(maxThreads() + 1);
+    return table;
+}
+
+// Uncontended with one thread, a handoff between two threads each time otherwise
+template <typename Table>
+void pickUp(benchmark::State& state) {
+    Table& table = sharedTable<Table>();
+    for (auto _ : state) {
+        table.acquire(0);
+        table.release(0);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <typename Table>
+void ring(benchmark::State& state) {
+    Table& table = sharedTable<Table>();
+    // A single thread takes chopsticks 0 and 1: a ring of one seat would need the same one twice
+    const int seats = std::max(state.threads(), 2);
+    const int left = state.thread_index();
+    const int right = (left + 1) % seats;
+    for (auto _ : state) {
+        table.acquirePair(left, right);
+        table.releasePair(left, right);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// The seats of an N-seat table, as the philosopher loop computes them once per thread
+std::vector<Seat> seatsOf(const int numSeats, PhilosopherStats& stats) {
+    std::vector<Seat> seats;
+    for (int id = 0; id < numSeats; id++) {
+        seats.push_back(Seat{id, id, (id + 1) % numSeats, &stats});
+    }
+    return seats;
+}
+
+template <typename Strategy>
+void eatAround(benchmark::State& state, Strategy& strategy, const int numSeats) {
+    PhilosopherStats stats;
+    const std::vector<Seat> seats = seatsOf(numSeats, stats);
+    const std::stop_token stop;
+    std::size_t next = 0;
+    for (auto _ : state) {
+        const Seat& seat = seats[next];
+        strategy.acquire(seat, stop);
+        strategy.release(seat);
+        next = next + 1 == seats.size() ? 0 : next + 1;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <int N, ChopstickKind Kind>
+void dynamicMeal(benchmark::State& state) {
+    const std::unique_ptr<AcquisitionStrategy> strategy = makeStrategy(StrategyKind::Asymmetric, Kind, N);
+    eatAround(state, *strategy, N);
+}
+
+template <int N, typename Chopstick>
+void staticMeal(benchmark::State& state) {
+    const auto table = StaticTable<N, StrategyKind::Asymmetric, Chopstick>::create();
+    eatAround(state, *table, N);
+}
+
+void allThreadCounts(benchmark::internal::Benchmark* benchmark) {
+    benchmark->ThreadRange(1, maxThreads())->UseRealTime();
+}
+
+}  // namespace
+
+#define CHOPSTICK_BENCHMARKS(Table, name)                                                 \
+    BENCHMARK(pickUp<Table>)->Name("Uncontended/" name);                                  \
+    BENCHMARK(pickUp<Table>)->Name("PingPong/" name)->Threads(2)->UseRealTime();          \
+    BENCHMARK(ring<Table>)->Name("Ring/" name)->Apply(allThreadCounts)
+
+CHOPSTICK_BENCHMARKS(ChopstickTable<PaddedChopstick>, "semaphore");
+CHOPSTICK_BENCHMARKS(ChopstickTable<SpinParkChopstick>, "spin-park");
+CHOPSTICK_BENCHMARKS(ChopstickTable<TicketChopstick>, "ticket");
+CHOPSTICK_BENCHMARKS(BitmapTable, "cas-bitmap");
+
+#define MEAL_BENCHMARKS(N, Kind, Chopstick, name)                                        \
+    BENCHMARK(dynamicMeal<N, Kind>)->Name("Meal/dynamic/" name "/" #N);                  \
+    BENCHMARK(staticMeal<N, Chopstick>)->Name("Meal/static/" name "/" #N)
+
+MEAL_BENCHMARKS(5, ChopstickKind::Semaphore, PaddedChopstick, "semaphore");
+MEAL_BENCHMARKS(1024, ChopstickKind::Semaphore, PaddedChopstick, "semaphore");
+MEAL_BENCHMARKS(5, ChopstickKind::SpinPark, SpinParkChopstick, "spin-park");
+MEAL_BENCHMARKS(1024, ChopstickKind::SpinPark, SpinParkChopstick, "spin-park");
+
+int main(int argc, char* argv[]) {
+    initLogging(LogMode::Off, "", {});  // The strategies log every pickup
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,189 @@
+#include "chrome_trace.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+constexpr int PHILOSOPHERS_PID = 1;
+constexpr int CHOPSTICKS_PID = 2;
+constexpr std::size_t OUTPUT_BUFFER = std::size_t{1} << 20;
+
+// Trace Event timestamps are microseconds; three decimals keep the nanoseconds
+struct Micros {
+    long long whole;
+    long long fraction;
+};
+
+Micros micros(const std::int64_t ns) {
+    const std::int64_t clamped = std::max<std::int64_t>(ns, 0);
+    return Micros{static_cast<long long>(clamped / 1000), static_cast<long long>(clamped % 1000)};
+}
+
+}  // namespace
+
+ChromeTraceSink::ChromeTraceSink(const std::string& path, const int numPhilosophers, const int numChopsticks)
+    : out_(std::fopen(path.c_str(), "w")),
+      buffer_(OUTPUT_BUFFER),
+      startNs_(std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::system_clock::now().time_since_epoch()).count()),
+      philosophers_(numPhilosophers) {
+    if (out_ == nullptr) {
+        throw std::runtime_error("cannot create trace file '" + path + "': " + std::strerror(errno));
+    }
+    std::setvbuf(out_, buffer_.data(), _IOFBF, buffer_.size());
+
+    std::fputs("{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n", out_);
+    separate();
+    std::fprintf(out_, R"({"ph": "M", "pid": %d, "name": "process_name", "args": {"name": "Philosophers"}})",
+                 PHILOSOPHERS_PID);
+    separate();
+    std::fprintf(out_, R"({"ph": "M", "pid": %d, "name": "process_name", "args": {"name": "Chopsticks"}})",
+                 CHOPSTICKS_PID);
+    for (int i = 0; i < numPhilosophers; i++) {
+        writeTrackName(PHILOSOPHERS_PID, i, "Philosopher");
+    }
+    for (int i = 0; i < numChopsticks; i++) {
+        writeTrackName(CHOPSTICKS_PID, i, "Chopstick");
+    }
+}
+
+ChromeTraceSink::~ChromeTraceSink() {
+    close();
+}
+
+void ChromeTraceSink::write(const std::span<const LogRecord> records) {
+    if (out_ == nullptr) {
+        return;
+    }
+    for (const LogRecord& record : records) {
+        add(record);
+    }
+}
+
+void ChromeTraceSink::close() {
+    if (out_ == nullptr) {
+        return;
+    }
+    // Slices open at the end of the run end at the last event
+    for (std::size_t i = 0; i < philosophers_.size(); i++) {
+        const auto id = static_cast<std::int32_t>(i);
+        PhilosopherSlices& slices = philosophers_[i];
+        endSlice(slices.thinkingSince, lastNs_, id, "think");
+        endSlice(slices.hungrySince, lastNs_, id, "hungry");
+        endSlice(slices.eatingSince, lastNs_, id, "eat");
+        releaseAll(slices, id, lastNs_);
+    }
+    std::fputs("\n]}\n", out_);
+    std::fclose(out_);
+    out_ = nullptr;
+}
+
+void ChromeTraceSink::add(const LogRecord& record) {
+    if (record.philosopherID < 0 || static_cast<std::size_t>(record.philosopherID) >= philosophers_.size()) {
+        return;
+    }
+    const std::int64_t time = record.timestampNs - startNs_;
+    lastNs_ = std::max(lastNs_, time);
+    PhilosopherSlices& slices = philosophers_[record.philosopherID];
+
+    switch (record.event) {
+        case Event::Thinking:
+            slices.thinkingSince = time;
+            break;
+        case Event::Thought:
+            endSlice(slices.thinkingSince, time, record.philosopherID, "think");
+            break;
+        case Event::Hungry:
+            slices.hungrySince = time;
+            break;
+        case Event::PickedLeft:
+        case Event::PickedRight:
+            if (slices.held < 2 && record.chopstick >= 0) {
+                slices.heldChopstick[slices.held] = record.chopstick;
+                slices.heldSince[slices.held] = time;
+                slices.held++;
+            }
+            break;
+        case Event::Eating:
+            endSlice(slices.hungrySince, time, record.philosopherID, "hungry");
+            slices.eatingSince = time;
+            break;
+        case Event::Ate:
+            endSlice(slices.eatingSince, time, record.philosopherID, "eat");
+            break;
+        case Event::PutDown:
+            releaseAll(slices, record.philosopherID, time);
+            break;
+    }
+}
+
+void ChromeTraceSink::endSlice(std::int64_t& since, const std::int64_t endNs, const std::int32_t philosopherID,
+                               const char* name) {
+    if (since == NONE) {
+        return;
+    }
+    writeSlice(PHILOSOPHERS_PID, philosopherID, name, -1, since, endNs);
+    since = NONE;
+}
+
+void ChromeTraceSink::releaseAll(PhilosopherSlices& slices, const std::int32_t philosopherID, const std::int64_t endNs) {
+    for (int i = 0; i < slices.held; i++) {
+        writeSlice(CHOPSTICKS_PID, slices.heldChopstick[i], "held by ", philosopherID, slices.heldSince[i], endNs);
+    }
+    slices.held = 0;
+}
+
+void ChromeTraceSink::writeSlice(const int pid, const std::int32_t track, const char* name,
+                                 const std::int32_t nameNumber, const std::int64_t beginNs, const std::int64_t endNs) {
+    // Formatted by hand into a reused line: this runs for every slice, and printf would
+    // dominate the drainer
+    line_.clear();
+    const auto appendNumber = [&](const long long number) {
+        char digits[24];
+        line_.append(digits, std::to_chars(digits, digits + sizeof(digits), number).ptr);
+    };
+    const auto appendMicros = [&](const std::int64_t ns) {
+        const Micros value = micros(ns);
+        appendNumber(value.whole);
+        const char fraction[4] = {'.', static_cast<char>('0' + value.fraction / 100),
+                                  static_cast<char>('0' + value.fraction / 10 % 10),
+                                  static_cast<char>('0' + value.fraction % 10)};
+        line_.append(fraction, sizeof(fraction));
+    };
+
+    line_ += R"({"ph": "X", "pid": )";
+    appendNumber(pid);
+    line_ += R"(, "tid": )";
+    appendNumber(track);
+    line_ += R"(, "ts": )";
+    appendMicros(beginNs);
+    line_ += R"(, "dur": )";
+    appendMicros(endNs - beginNs);
+    line_ += R"(, "name": ")";
+    line_ += name;
+    if (nameNumber >= 0) {
+        appendNumber(nameNumber);
+    }
+    line_ += "\"}";
+
+    separate();
+    std::fwrite(line_.data(), 1, line_.size(), out_);
+}
+
+void ChromeTraceSink::writeTrackName(const int pid, const std::int32_t track, const char* kind) {
+    separate();
+    std::fprintf(out_, R"({"ph": "M", "pid": %d, "tid": %d, "name": "thread_name", "args": {"name": "%s %d"}})",
+                 pid, track, kind, track);
+}
+
+void ChromeTraceSink::separate() {
+    if (!first_) {
+        std::fputs(",\n", out_);
+    }
+    first_ = false;
+}
@@ -0,0 +1,65 @@
+/*
+    ChromeTrace
+    -----------
+    Trace sink writing the event stream in the Chrome Trace Event format, which
+    chrome://tracing and the Perfetto UI (ui.perfetto.dev) open directly.
+
+    Every philosopher is a track of "think", "hungry" and "eat" slices, and every chopstick
+    is a track of "held by N" slices from the pick-up to the put-down. A slice is written as
+    one complete ("X") event when it ends, so the sink keeps only the open slices in memory
+    and the file streams out as the run goes. Like every sink it runs on the logger's drainer
+    thread: a traced philosopher only pushes its fixed-size record into its ring buffer.
+*/
+
+#pragma once
+
+#include "logger.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <span>
+#include <string>
+#include <vector>
+
+class ChromeTraceSink final : public TraceSink {
+public:
+    // Creates or truncates the file. Throws std::runtime_error if it cannot be created.
+    ChromeTraceSink(const std::string& path, int numPhilosophers, int numChopsticks);
+    ~ChromeTraceSink() override;
+
+    ChromeTraceSink(const ChromeTraceSink&) = delete;
+    ChromeTraceSink& operator=(const ChromeTraceSink&) = delete;
+
+    void write(std::span<const LogRecord> records) override;
+
+    // Ends the slices still open and completes the JSON document
+    void close() override;
+
+private:
+    static constexpr std::int64_t NONE = -1;
+
+    struct PhilosopherSlices {
+        std::int64_t thinkingSince = NONE;
+        std::int64_t hungrySince = NONE;
+        std::int64_t eatingSince = NONE;
+        int held = 0;
+        std::int32_t heldChopstick[2] = {};
+        std::int64_t heldSince[2] = {};
+    };
+
+    void add(const LogRecord& record);
+    void endSlice(std::int64_t& since, std::int64_t endNs, std::int32_t philosopherID, const char* name);
+    void releaseAll(PhilosopherSlices& slices, std::int32_t philosopherID, std::int64_t endNs);
+    void writeSlice(int pid, std::int32_t track, const char* name, std::int32_t nameNumber,
+                    std::int64_t beginNs, std::int64_t endNs);
+    void writeTrackName(int pid, std::int32_t track, const char* kind);
+    void separate();  // Comma between the events of the array
+
+    std::FILE* out_;
+    std::vector<char> buffer_;  // stdio buffer of out_
+    std::string line_;          // Slice being formatted, reused
+    std::int64_t startNs_;
+    std::int64_t lastNs_ = 0;
+    bool first_ = true;
+    std::vector<PhilosopherSlices> philosophers_;
+};
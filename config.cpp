@@ -0,0 +1,536 @@
+#include "config.h"
+
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+
+#include <arpa/inet.h>
+
+namespace {
+
+LogMode parseLogMode(const std::string& value) {
+    if (value == "sync") {
+        return LogMode::Sync;
+    }
+    if (value == "async") {
+        return LogMode::Async;
+    }
+    if (value == "off") {
+        return LogMode::Off;
+    }
+    throw std::invalid_argument("unknown log mode '" + value + "'");
+}
+
+Mode parseMode(const std::string& value) {
+    if (value == "simulate") {
+        return Mode::Simulate;
+    }
+    if (value == "bench") {
+        return Mode::Bench;
+    }
+    if (value == "layout-bench") {
+        return Mode::LayoutBench;
+    }
+    if (value == "des") {
+        return Mode::Des;
+    }
+    if (value == "graph-bench") {
+        return Mode::GraphBench;
+    }
+    if (value == "sweep") {
+        return Mode::Sweep;
+    }
+    throw std::invalid_argument("unknown mode '" + value + "'");
+}
+
+Executor parseExecutor(const std::string& value) {
+    for (const Executor executor : {Executor::Threads, Executor::Pool, Executor::Coroutine}) {
+        if (value == executorName(executor)) {
+            return executor;
+        }
+    }
+    throw std::invalid_argument("unknown executor '" + value + "'");
+}
+
+StrategyKind parseStrategy(const std::string& value) {
+    for (const StrategyKind kind : {StrategyKind::Asymmetric, StrategyKind::Hierarchy, StrategyKind::Waiter,
+                                    StrategyKind::ChandyMisra, StrategyKind::CasBitmap, StrategyKind::Naive,
+                                    StrategyKind::Backoff, StrategyKind::Arbiter}) {
+        if (value == strategyName(kind)) {
+            return kind;
+        }
+    }
+    throw std::invalid_argument("unknown strategy '" + value + "'");
+}
+
+ChopstickKind parseChopstick(const std::string& value) {
+    for (const ChopstickKind kind : {ChopstickKind::Semaphore, ChopstickKind::SpinPark, ChopstickKind::Ticket}) {
+        if (value == chopstickName(kind)) {
+            return kind;
+        }
+    }
+    throw std::invalid_argument("unknown chopstick primitive '" + value + "'");
+}
+
+PlacementPolicy parsePlacement(const std::string& value) {
+    for (const PlacementPolicy policy : {PlacementPolicy::None, PlacementPolicy::Compact, PlacementPolicy::Scatter}) {
+        if (value == placementName(policy)) {
+            return policy;
+        }
+    }
+    throw std::invalid_argument("unknown placement policy '" + value + "'");
+}
+
+long long parseInteger(const std::string& name, const std::string& value, const long long min, const long long max) {
+    std::size_t consumed = 0;
+    long long result = 0;
+    try {
+        result = std::stoll(value, &consumed);
+    } catch (const std::exception&) {
+        consumed = 0;
+    }
+    if (consumed == 0 || consumed != value.size()) {
+        throw std::invalid_argument("'--" + name + "' expects an integer, got '" + value + "'");
+    }
+    if (result < min || result > max) {
+        throw std::invalid_argument("'--" + name + "' must be between " + std::to_string(min) +
+                                    " and " + std::to_string(max));
+    }
+    return result;
+}
+
+double parseFraction(const std::string& name, const std::string& value) {
+    std::size_t consumed = 0;
+    double result = 0.0;
+    try {
+        result = std::stod(value, &consumed);
+    } catch (const std::exception&) {
+        consumed = 0;
+    }
+    if (consumed == 0 || consumed != value.size()) {
+        throw std::invalid_argument("'--" + name + "' expects a number, got '" + value + "'");
+    }
+    if (!(result >= 0.0 && result <= 1.0)) {
+        throw std::invalid_argument("'--" + name + "' must be between 0 and 1");
+    }
+    return result;
+}
+
+bool parseSwitch(const std::string& name, const std::string& value) {
+    if (value != "on" && value != "off") {
+        throw std::invalid_argument("'--" + name + "' expects on or off, got '" + value + "'");
+    }
+    return value == "on";
+}
+
+DurationModel parseDurationModel(const std::string& name, const std::string& value) {
+    try {
+        return DurationModel::parse(value);
+    } catch (const std::invalid_argument& e) {
+        throw std::invalid_argument("'--" + name + "': " + e.what());
+    }
+}
+
+// Parses "ID:SPEC" for the per-philosopher override options
+std::pair<int, DurationModel> parseOverride(const std::string& name, const std::string& value) {
+    const auto colon = value.find(':');
+    if (colon == std::string::npos) {
+        throw std::invalid_argument("'--" + name + "' expects ID:SPEC, got '" + value + "'");
+    }
+    const int id = static_cast<int>(parseInteger(name, value.substr(0, colon), 0, 999'999));
+    return {id, parseDurationModel(name, value.substr(colon + 1))};
+}
+
+}  // namespace
+
+const char* executorName(const Executor executor) {
+    switch (executor) {
+        case Executor::Threads:
+            return "threads";
+        case Executor::Pool:
+            return "pool";
+        case Executor::Coroutine:
+            return "coroutine";
+    }
+    return "unknown";
+}
+
+CoursePolicy CoursePolicy::parse(const std::string& spec) {
+    const std::size_t colon = spec.find(':');
+    if (colon != std::string::npos && spec.substr(0, colon) != "adaptive") {
+        throw std::invalid_argument("invalid courses spec '" + spec + "', expected B or adaptive:B");
+    }
+    CoursePolicy policy;
+    policy.adaptive = colon != std::string::npos;
+    policy.maxCourses = static_cast<int>(
+        parseInteger("courses", colon == std::string::npos ? spec : spec.substr(colon + 1), 1, 1'000'000));
+    return policy;
+}
+
+std::string CoursePolicy::describe() const {
+    return (adaptive ? "adaptive:" : "") + std::to_string(maxCourses);
+}
+
+SweepAxis SweepAxis::parse(const std::string& spec) {
+    const std::size_t eq = spec.find('=');
+    if (eq == std::string::npos || eq == 0 || eq + 1 == spec.size()) {
+        throw std::invalid_argument("invalid sweep axis '" + spec + "', expected NAME=V1,V2,...");
+    }
+    SweepAxis axis;
+    axis.name = spec.substr(0, eq);
+    std::size_t begin = eq + 1;
+    while (true) {
+        const std::size_t comma = spec.find(',', begin);
+        const std::string value = spec.substr(begin, comma == std::string::npos ? std::string::npos : comma - begin);
+        if (value.empty()) {
+            throw std::invalid_argument("empty value in sweep axis '" + spec + "'");
+        }
+        axis.values.push_back(value);
+        if (comma == std::string::npos) {
+            break;
+        }
+        begin = comma + 1;
+    }
+    return axis;
+}
+
+Shard Shard::parse(const std::string& spec) {
+    const std::size_t slash = spec.find('/');
+    if (slash == std::string::npos) {
+        throw std::invalid_argument("invalid shard '" + spec + "', expected I/N");
+    }
+    Shard shard;
+    shard.count = static_cast<int>(parseInteger("shard", spec.substr(slash + 1), 1, 1'000'000));
+    shard.index = static_cast<int>(parseInteger("shard", spec.substr(0, slash), 0, shard.count - 1));
+    return shard;
+}
+
+std::string Shard::describe() const {
+    return std::to_string(index) + "/" + std::to_string(count);
+}
+
+MetricsAddress MetricsAddress::parse(const std::string& spec) {
+    MetricsAddress address;
+    const std::size_t colon = spec.rfind(':');
+    if (colon != std::string::npos) {
+        address.host = spec.substr(0, colon);
+        in_addr parsed{};
+        if (inet_pton(AF_INET, address.host.c_str(), &parsed) != 1) {
+            throw std::invalid_argument("invalid metrics host '" + address.host + "', expected an IPv4 address");
+        }
+    }
+    address.port = static_cast<int>(
+        parseInteger("metrics", colon == std::string::npos ? spec : spec.substr(colon + 1), 1, 65535));
+    return address;
+}
+
+std::string MetricsAddress::describe() const {
+    return host + ":" + std::to_string(port);
+}
+
+Config parseArgs(const int argc, char* argv[]) {
+    Config config;
+    bool logModeSet = false;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            config.help = true;  // Takes no value; the rest of the line is not checked
+            return config;
+        }
+        if (arg.rfind("--", 0) != 0) {
+            throw std::invalid_argument("unexpected argument '" + arg + "'");
+        }
+
+        // Split "--name=value"; otherwise the value is the next argument
+        std::string name = arg.substr(2);
+        std::string value;
+        if (const auto eq = name.find('='); eq != std::string::npos) {
+            value = name.substr(eq + 1);
+            name.resize(eq);
+        } else if (i + 1 < argc) {
+            value = argv[++i];
+        } else {
+            throw std::invalid_argument("missing value for '--" + name + "'");
+        }
+
+        if (name == "mode") {
+            config.mode = parseMode(value);
+        } else if (name == "philosophers") {
+            config.numPhilosophers = static_cast<int>(parseInteger(name, value, 2, 1'000'000));
+        } else if (name == "strategy") {
+            config.strategy = parseStrategy(value);
+        } else if (name == "chopstick") {
+            config.chopstick = parseChopstick(value);
+        } else if (name == "executor") {
+            config.executor = parseExecutor(value);
+        } else if (name == "placement") {
+            config.placement = parsePlacement(value);
+        } else if (name == "backoff") {
+            config.backoff = BackoffPolicy::parse(value);
+        } else if (name == "courses") {
+            config.courses = CoursePolicy::parse(value);
+        } else if (name == "static-table") {
+            config.staticTable = parseSwitch(name, value);
+        } else if (name == "perf-counters") {
+            config.perfCounters = parseSwitch(name, value);
+        } else if (name == "metrics") {
+            config.metrics = MetricsAddress::parse(value);
+        } else if (name == "sweep") {
+            config.sweep.push_back(SweepAxis::parse(value));
+        } else if (name == "shard") {
+            config.shard = Shard::parse(value);
+        } else if (name == "sweep-format") {
+            if (value != "csv" && value != "json") {
+                throw std::invalid_argument("unknown sweep format '" + value + "'");
+            }
+            config.sweepFormat = value == "csv" ? SweepFormat::Csv : SweepFormat::Json;
+        } else if (name == "jobs") {
+            config.jobs = static_cast<int>(parseInteger(name, value, 0, 100'000));
+        } else if (name == "topology") {
+            config.topology = TopologySpec::parse(value);
+        } else if (name == "log") {
+            config.logMode = parseLogMode(value);
+            logModeSet = true;
+        } else if (name == "log-file") {
+            config.logFile = value;
+        } else if (name == "trace-file") {
+            config.traceFile = value;
+        } else if (name == "chrome-trace") {
+            config.chromeTraceFile = value;
+        } else if (name == "stats-interval-ms") {
+            config.statsIntervalMs = static_cast<int>(parseInteger(name, value, 0, 86'400'000));
+        } else if (name == "wait-slo-ms") {
+            config.waitSloMs = static_cast<int>(parseInteger(name, value, 0, 86'400'000));
+        } else if (name == "fairness-threshold") {
+            config.fairnessThreshold = parseFraction(name, value);
+        } else if (name == "deadlock-check-ms") {
+            config.deadlockCheckMs = static_cast<int>(parseInteger(name, value, 0, 86'400'000));
+        } else if (name == "duration-ms") {
+            config.durationMs = static_cast<int>(parseInteger(name, value, 0, 86'400'000));
+        } else if (name == "think") {
+            config.think = parseDurationModel(name, value);
+        } else if (name == "eat") {
+            config.eat = parseDurationModel(name, value);
+        } else if (name == "think-ms") {
+            config.think = DurationModel(std::chrono::milliseconds(parseInteger(name, value, 0, 86'400'000)));
+        } else if (name == "eat-ms") {
+            config.eat = DurationModel(std::chrono::milliseconds(parseInteger(name, value, 0, 86'400'000)));
+        } else if (name == "think-override") {
+            config.thinkOverrides.push_back(parseOverride(name, value));
+        } else if (name == "eat-override") {
+            config.eatOverrides.push_back(parseOverride(name, value));
+        } else if (name == "seed") {
+            config.seed = static_cast<std::uint64_t>(parseInteger(name, value, 0, INT64_MAX));
+        } else if (name == "meals") {
+            config.meals = parseInteger(name, value, 0, 1'000'000'000'000LL);
+        } else if (name == "threads") {
+            config.threads = static_cast<int>(parseInteger(name, value, 0, 100'000));
+        } else {
+            throw std::invalid_argument("unknown option '--" + name + "'");
+        }
+    }
+
+    // The other options of a sweep apply to its runs, which are checked once the grid is expanded
+    if (config.mode == Mode::Sweep) {
+        return config;
+    }
+    if (!config.sweep.empty() || config.shard.count != 1) {
+        throw std::invalid_argument("--sweep and --shard need --mode=sweep");
+    }
+
+    for (const auto* overrides : {&config.thinkOverrides, &config.eatOverrides}) {
+        for (const auto& [id, model] : *overrides) {
+            if (id >= config.numPhilosophers) {
+                throw std::invalid_argument("override for philosopher " + std::to_string(id) +
+                                            " but the table has only " +
+                                            std::to_string(config.numPhilosophers) + " seats");
+            }
+        }
+    }
+
+    // Suspended philosophers wait on task chopsticks, which only the ordering strategies use
+    if (config.mode != Mode::Des && config.executor != Executor::Threads && config.strategy != StrategyKind::Asymmetric &&
+        config.strategy != StrategyKind::Hierarchy && config.strategy != StrategyKind::Waiter &&
+        config.strategy != StrategyKind::Naive) {
+        throw std::invalid_argument("strategy '" + strategyName(config.strategy) +
+                                    "' is not supported by the " +
+                                    executorName(config.executor) + " executor");
+    }
+
+    // A drawn ticket cannot be handed back, so a philosopher stuck in the naive deadlock
+    // would wait for its turn forever, past the end of the run
+    if (config.mode != Mode::Des && config.executor == Executor::Threads && config.strategy == StrategyKind::Naive &&
+        config.chopstick == ChopstickKind::Ticket) {
+        throw std::invalid_argument("strategy 'naive' cannot stop once deadlocked on ticket chopsticks; "
+                                    "use --chopstick=semaphore or spin-park");
+    }
+
+    // The watchdog samples wall-clock waits, which a virtual-time run does not have
+    if (config.mode == Mode::Des && (config.waitSloMs != 0 || config.fairnessThreshold != 0.0)) {
+        throw std::invalid_argument("the watchdog options are not supported in des mode");
+    }
+
+    // Virtual time has no timed waits to give up on
+    if (config.mode == Mode::Des && config.strategy == StrategyKind::Backoff) {
+        throw std::invalid_argument("strategy 'backoff' is not supported in des mode");
+    }
+
+    // The arbiter's cost is the round trip through its thread, which virtual time leaves out
+    if (config.mode == Mode::Des && config.strategy == StrategyKind::Arbiter) {
+        throw std::invalid_argument("strategy 'arbiter' is not supported in des mode");
+    }
+
+    // Virtual time has no acquisition cost to amortize
+    if (config.mode == Mode::Des && config.courses.maxCourses != 1) {
+        throw std::invalid_argument("--courses is not supported in des mode");
+    }
+
+    // A deadlocked simulation simply runs out of events
+    if (config.mode == Mode::Des && config.deadlockCheckMs != 0) {
+        throw std::invalid_argument("--deadlock-check-ms is not supported in des mode");
+    }
+
+    // Placement applies to the dining table: virtual time runs on no CPU at all, and the
+    // layout benchmark keeps its own workers
+    if ((config.mode == Mode::Des || config.mode == Mode::LayoutBench) && config.placement != PlacementPolicy::None) {
+        throw std::invalid_argument("--placement is not supported in des and layout-bench modes");
+    }
+
+    // The resource graph runs one thread per worker with table-wide think/eat models
+    if (config.mode == Mode::GraphBench) {
+        if (config.executor != Executor::Threads || config.placement != PlacementPolicy::None ||
+            !config.thinkOverrides.empty() || !config.eatOverrides.empty() ||
+            config.waitSloMs != 0 || config.fairnessThreshold != 0.0 || config.deadlockCheckMs != 0 ||
+            config.courses.maxCourses != 1) {
+            throw std::invalid_argument("graph-bench supports neither other executors, placement, overrides, "
+                                        "the watchdog, the deadlock detector nor --courses");
+        }
+    }
+
+    // The counters are opened per philosopher thread and reported with the benchmark results
+    if (config.perfCounters && (config.mode != Mode::Bench || config.executor != Executor::Threads)) {
+        throw std::invalid_argument("--perf-counters needs --mode=bench and the threads executor");
+    }
+
+    // The endpoint serves the counters of a live dining table
+    if (config.metrics.enabled() && config.mode != Mode::Simulate && config.mode != Mode::Bench) {
+        throw std::invalid_argument("--metrics is only supported in simulate and bench modes");
+    }
+
+    // Benchmarks measure the table, not the console, unless logging is asked for explicitly
+    if (config.mode == Mode::Bench && !logModeSet) {
+        config.logMode = LogMode::Off;
+    }
+
+    // Virtual time only advances through think and eat periods: a philosopher without either
+    // would eat forever at the same instant
+    if (config.mode == Mode::Des && config.meals == 0) {
+        const auto instant = [](const DurationModel& think, const DurationModel& eat) {
+            return think.mean() == std::chrono::nanoseconds::zero() && eat.mean() == std::chrono::nanoseconds::zero();
+        };
+        std::map<int, std::pair<DurationModel, DurationModel>> overridden;
+        for (const auto& [id, model] : config.thinkOverrides) {
+            overridden.try_emplace(id, config.think, config.eat).first->second.first = model;
+        }
+        for (const auto& [id, model] : config.eatOverrides) {
+            overridden.try_emplace(id, config.think, config.eat).first->second.second = model;
+        }
+        bool foreverAtOnce = static_cast<int>(overridden.size()) < config.numPhilosophers &&
+                             instant(config.think, config.eat);
+        for (const auto& [id, models] : overridden) {
+            foreverAtOnce = foreverAtOnce || instant(models.first, models.second);
+        }
+        if (foreverAtOnce) {
+            throw std::invalid_argument("des mode needs --meals when a philosopher neither thinks nor eats");
+        }
+    }
+
+    // Benchmarks always terminate: without a limit they measure one second (of virtual time:
+    // one hour)
+    const bool unbounded = config.durationMs == 0 && (config.meals == 0 || config.mode == Mode::LayoutBench);
+    if (config.mode != Mode::Simulate && unbounded) {
+        config.durationMs = config.mode == Mode::Des ? 3'600'000 : 1000;
+    }
+
+    return config;
+}
+
+void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [options]\n"
+              << "  --mode=MODE          simulate: logged simulation until a limit or Ctrl-C (default)\n"
+              << "                       bench: bounded run, throughput and wait latency as JSON\n"
+              << "                       layout-bench: padded vs. packed chopstick throughput\n"
+              << "                       des: deterministic discrete-event simulation in virtual\n"
+              << "                       time, fairness and throughput as JSON\n"
+              << "                       graph-bench: workers taking their resource sets on the\n"
+              << "                       --topology resource graph, throughput and wait as JSON\n"
+              << "                       sweep: every point of the --sweep grid as a bounded run in\n"
+              << "                       a child process (bench unless mode is an axis), one CSV\n"
+              << "                       or JSON result set on stdout\n"
+              << "  --philosophers=N     number of philosophers (and chopsticks) at the table (default: 5)\n"
+              << "  --strategy=NAME      chopstick acquisition strategy (default: asymmetric):\n"
+              << "                       asymmetric, hierarchy, waiter, chandy-misra, cas-bitmap,\n"
+              << "                       naive (deadlocks; for the deadlock detector), backoff,\n"
+              << "                       arbiter (central thread granting fork pairs)\n"
+              << "  --chopstick=NAME     chopstick primitive: semaphore (default), spin-park or\n"
+              << "                       ticket (FIFO)\n"
+              << "  --executor=NAME      threads: one thread per philosopher (default)\n"
+              << "                       pool: philosophers as tasks on a work-stealing pool of\n"
+              << "                       --threads workers\n"
+              << "                       coroutine: philosophers as coroutines on one thread\n"
+              << "                       (pool and coroutine: ordering strategies and waiter only)\n"
+              << "  --placement=NAME     pin philosopher threads (pool workers) and place chopstick\n"
+              << "                       memory: none (default), compact (neighbours share a core,\n"
+              << "                       L3 and NUMA node) or scatter (round-robin across sockets)\n"
+              << "  --backoff=TRY:MIN:MAX  backoff strategy: wait TRY for the second chopstick, then\n"
+              << "                       put the first back and sleep a random delay below a ceiling\n"
+              << "                       doubling from MIN to MAX (default: 100us:10us:5ms)\n"
+              << "  --courses=B          eat up to B courses per pickup of the chopsticks (default: 1);\n"
+              << "                       adaptive:B ends the meal once a neighbour is hungry\n"
+              << "  --static-table=on|off  run 5, 16, 64 or 1024 philosophers with the asymmetric or\n"
+              << "                       hierarchy strategy on a table specialized at compile time\n"
+              << "                       (threads executor, no placement; default: on)\n"
+              << "  --perf-counters=on|off  bench: count cycles, instructions, cache misses, context\n"
+              << "                       switches and CPU time per philosopher thread with\n"
+              << "                       perf_event_open, and the share spent in acquire()\n"
+              << "                       (threads executor; default: off)\n"
+              << "  --metrics=[HOST:]PORT  serve live counters in the Prometheus text format on\n"
+              << "                       http://HOST:PORT/metrics (HOST defaults to 127.0.0.1)\n"
+              << "  --sweep=NAME=V1,V2,...  sweep axis: run with --NAME=V1, --NAME=V2, ... (repeatable;\n"
+              << "                       the grid is every combination; other options apply to all)\n"
+              << "  --shard=I/N          sweep: run only the grid points whose index is I modulo N\n"
+              << "  --sweep-format=csv|json  sweep result set: one CSV row per run (default) or\n"
+              << "                       every report in one JSON document\n"
+              << "  --jobs=N             sweep: des runs in parallel, 0 = hardware concurrency (default: 0);\n"
+              << "                       wall-clock runs always run one at a time\n"
+              << "  --topology=SPEC      graph-bench resource graph: ring (default), grid:RxC,\n"
+              << "                       random:K (K-regular, --philosophers workers) or file:PATH\n"
+              << "  --think=SPEC         thinking time per meal (default: constant:3000ms)\n"
+              << "  --eat=SPEC           eating time per meal (default: constant:3000ms)\n"
+              << "                       SPEC: constant:D, uniform:MIN:MAX, exp:MEAN or spin:D,\n"
+              << "                       durations with ns/us/ms/s units (bare numbers are ms)\n"
+              << "  --think-ms=N, --eat-ms=N  shorthand for constant:Nms\n"
+              << "  --think-override=ID:SPEC, --eat-override=ID:SPEC\n"
+              << "                       per-philosopher duration model (repeatable)\n"
+              << "  --seed=N             seed of the philosophers' random streams (default: 1)\n"
+              << "  --log=sync|async|off synchronous logging, per-thread ring buffers drained by a\n"
+              << "                       background thread, or no logging (default: sync; off for bench)\n"
+              << "  --log-file=PATH      write the log to PATH instead of stdout\n"
+              << "  --trace-file=PATH    record every event in a binary trace for trace-analyzer\n"
+              << "  --chrome-trace=PATH  write philosopher and chopstick timelines as Chrome Trace\n"
+              << "                       Event JSON (chrome://tracing, ui.perfetto.dev)\n"
+              << "  --stats-interval-ms=N  print the live counter table to stderr every N ms\n"
+              << "                       (default: 0, only on SIGUSR1)\n"
+              << "  --wait-slo-ms=N      watchdog: flag philosophers hungry for longer than N ms\n"
+              << "  --fairness-threshold=F  watchdog: flag philosophers with fewer than F x the mean\n"
+              << "                       meals, 0 < F <= 1 (default: both off)\n"
+              << "  --deadlock-check-ms=N  sample the wait-for graph every N ms and report cycles\n"
+              << "                       (default: 0, off)\n"
+              << "  --duration-ms=N      stop the run after N ms (default: no limit; 1000 for benchmarks;\n"
+              << "                       virtual ms for des, default: one hour)\n"
+              << "  --meals=N            stop each philosopher after N meals (default: no limit)\n"
+              << "  --threads=N          benchmark and pool workers, 0 = hardware concurrency (default: 0)\n"
+              << "  --help, -h           print this list and exit\n";
+}
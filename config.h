@@ -0,0 +1,167 @@
+/*
+    Config
+    ------
+    Run-time configuration of the simulation, parsed from the command line.
+*/
+
+#pragma once
+
+#include "duration.h"
+#include "logger.h"
+#include "placement.h"
+#include "resource_graph.h"
+#include "strategy.h"
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+enum class Mode {
+    Simulate,     // Logged simulation, endless unless a duration or meal limit is given
+    Bench,        // Bounded run reporting throughput and wait latency as JSON
+    LayoutBench,  // Padded vs. packed chopstick throughput
+    Des,          // Deterministic discrete-event simulation in virtual time
+    GraphBench,   // Workers acquiring resource sets on a resource graph
+    Sweep         // Grid of bounded runs in child processes, one consolidated result set
+};
+
+enum class Executor {
+    Threads,  // One OS thread per philosopher
+    Pool,      // Philosophers as tasks on a work-stealing worker pool (see task_philosopher.h)
+    Coroutine  // Philosophers as coroutines on one event-loop thread (see coroutine_philosopher.h)
+};
+
+// Command-line name of an executor
+const char* executorName(Executor executor);
+
+// Courses a philosopher may eat per acquisition of its chopsticks, --courses=[adaptive:]B
+struct CoursePolicy {
+    int maxCourses = 1;
+    bool adaptive = false;  // End the meal early once a neighbour is hungry
+
+    /*
+        Function: parse
+        ---------------
+        Parses "B" or "adaptive:B". Throws std::invalid_argument when malformed.
+    */
+    static CoursePolicy parse(const std::string& spec);
+
+    // Canonical spec, e.g. "adaptive:8"
+    std::string describe() const;
+};
+
+// One dimension of a parameter sweep, --sweep=NAME=V1,V2,...: the values of option --NAME
+struct SweepAxis {
+    std::string name;
+    std::vector<std::string> values;
+
+    /*
+        Function: parse
+        ---------------
+        Parses "NAME=V1,V2,...". Throws std::invalid_argument when malformed.
+    */
+    static SweepAxis parse(const std::string& spec);
+};
+
+// Part of a sweep grid run on this host, --shard=I/N: the points whose index is I modulo N
+struct Shard {
+    int index = 0;
+    int count = 1;
+
+    /*
+        Function: parse
+        ---------------
+        Parses "I/N" with 0 <= I < N. Throws std::invalid_argument when malformed.
+    */
+    static Shard parse(const std::string& spec);
+
+    bool contains(const int point) const { return point % count == index; }
+
+    // Canonical spec, e.g. "0/4"
+    std::string describe() const;
+};
+
+enum class SweepFormat {
+    Csv,  // One row per run, selected metrics
+    Json  // Every run with its complete report
+};
+
+// Listen address of the Prometheus metrics endpoint, --metrics=[HOST:]PORT
+struct MetricsAddress {
+    std::string host = "127.0.0.1";  // IPv4 address; 0.0.0.0 listens on every interface
+    int port = 0;                    // 0 = no endpoint
+
+    /*
+        Function: parse
+        ---------------
+        Parses "PORT" or "HOST:PORT". Throws std::invalid_argument when malformed.
+    */
+    static MetricsAddress parse(const std::string& spec);
+
+    bool enabled() const { return port != 0; }
+
+    // Canonical spec, e.g. "127.0.0.1:9464"
+    std::string describe() const;
+};
+
+struct Config {
+    bool help = false;                // --help or -h, print the usage and exit
+    Mode mode = Mode::Simulate;       // --mode=simulate|bench|layout-bench|des|graph-bench|sweep
+    int numPhilosophers = 5;          // --philosophers=N
+    StrategyKind strategy = StrategyKind::Asymmetric;  // --strategy=NAME
+    ChopstickKind chopstick = ChopstickKind::Semaphore;  // --chopstick=NAME
+    Executor executor = Executor::Threads;  // --executor=threads|pool|coroutine
+    PlacementPolicy placement = PlacementPolicy::None;  // --placement=none|compact|scatter
+    BackoffPolicy backoff;            // --backoff=TRY:MIN:MAX, tuning of the backoff strategy
+    CoursePolicy courses;             // --courses=[adaptive:]B, courses per acquisition
+    bool staticTable = true;          // --static-table=on|off, compile-time tables for common sizes
+    bool perfCounters = false;        // --perf-counters=on|off, per-thread perf_event counters (bench)
+    MetricsAddress metrics;           // --metrics=[HOST:]PORT, live Prometheus endpoint (off by default)
+    // Parameter sweep (see sweep.h)
+    std::vector<SweepAxis> sweep;     // --sweep=NAME=V1,V2,... (repeatable), the grid's axes
+    Shard shard;                      // --shard=I/N, the grid points of this host
+    SweepFormat sweepFormat = SweepFormat::Csv;  // --sweep-format=csv|json
+    int jobs = 0;                     // --jobs=N, parallel des runs, 0 = hardware concurrency
+    TopologySpec topology;            // --topology=SPEC, resource graph of graph-bench
+    // Think/eat durations: table-wide models plus per-philosopher overrides
+    DurationModel think{std::chrono::milliseconds(3000)};  // --think=SPEC (or --think-ms=N)
+    DurationModel eat{std::chrono::milliseconds(3000)};    // --eat=SPEC (or --eat-ms=N)
+    std::vector<std::pair<int, DurationModel>> thinkOverrides;  // --think-override=ID:SPEC
+    std::vector<std::pair<int, DurationModel>> eatOverrides;    // --eat-override=ID:SPEC
+    std::uint64_t seed = 1;           // --seed=N, seeds every philosopher's random stream
+    LogMode logMode = LogMode::Sync;  // --log=sync|async|off (benchmarks default to off)
+    std::string logFile;              // --log-file=PATH (stdout when empty)
+    std::string traceFile;            // --trace-file=PATH, binary event trace (none when empty)
+    std::string chromeTraceFile;      // --chrome-trace=PATH, Chrome Trace Event JSON (none when empty)
+    int statsIntervalMs = 0;          // --stats-interval-ms=N, live counter table period (0 = SIGUSR1 only)
+
+    // Starvation watchdog (see watchdog.h); off when both are zero
+    int waitSloMs = 0;                // --wait-slo-ms=N, flag hungry waits longer than N ms
+    double fairnessThreshold = 0.0;   // --fairness-threshold=F, flag philosophers below F x the mean meals
+    int deadlockCheckMs = 0;          // --deadlock-check-ms=N, sample the wait-for graph every N ms (0 = off)
+
+    // Run limits; the first one reached ends the run
+    int durationMs = 0;               // --duration-ms=N, wall-time limit (0 = none; benchmarks default to 1000,
+                                      // des counts virtual time and defaults to one hour)
+    long long meals = 0;              // --meals=N, stop after N meals per philosopher (0 = unlimited)
+
+    // Benchmark settings
+    int threads = 0;                  // --threads=N, benchmark and pool workers (0 = hardware concurrency)
+};
+
+/*
+    Function: parseArgs
+    -------------------
+    Parses the command line into a Config. Options are accepted as "--name=value" or
+    "--name value". "--help" or "-h" sets Config::help and ends parsing. Throws
+    std::invalid_argument on unknown options or malformed values.
+*/
+Config parseArgs(int argc, char* argv[]);
+
+/*
+    Function: printUsage
+    --------------------
+    Prints the list of supported options.
+*/
+void printUsage(const char* program);
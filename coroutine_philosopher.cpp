@@ -0,0 +1,216 @@
+#include "coroutine_philosopher.h"
+#include "async_semaphore.h"
+#include "event_loop.h"
+#include "logger.h"
+#include "numa_array.h"
+
+#include <exception>
+#include <memory>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/*
+    Class: PhilosopherCoroutine
+    ---------------------------
+    Owning handle of a philosopher coroutine. The coroutine starts suspended, is resumed only
+    by the event loop, and is destroyed with its owner, wherever it is suspended.
+*/
+class PhilosopherCoroutine {
+public:
+    struct promise_type {
+        PhilosopherCoroutine get_return_object() {
+            return PhilosopherCoroutine(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    explicit PhilosopherCoroutine(const std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+    PhilosopherCoroutine(PhilosopherCoroutine&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+    PhilosopherCoroutine(const PhilosopherCoroutine&) = delete;
+    PhilosopherCoroutine& operator=(const PhilosopherCoroutine&) = delete;
+    PhilosopherCoroutine& operator=(PhilosopherCoroutine&&) = delete;
+
+    ~PhilosopherCoroutine() {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+
+    std::coroutine_handle<> handle() const { return handle_; }
+
+private:
+    std::coroutine_handle<promise_type> handle_;
+};
+
+/*
+    Class: Acquire
+    --------------
+    Awaitable taking a permit of an AsyncSemaphore: completes at once if one is free, otherwise
+    suspends until release() hands one over and posts the coroutine back to the loop.
+*/
+class Acquire final : public AsyncWaiter {
+public:
+    Acquire(EventLoop& loop, AsyncSemaphore& semaphore) : loop_(loop), semaphore_(semaphore) {}
+
+    bool await_ready() const { return false; }
+
+    // Resumes the caller right away (false) if the permit was free
+    bool await_suspend(const std::coroutine_handle<> handle) {
+        handle_ = handle;
+        return !semaphore_.acquireOrEnqueue(*this);
+    }
+
+    void await_resume() const {}
+
+    void wake() override { loop_.post(handle_); }
+
+private:
+    EventLoop& loop_;
+    AsyncSemaphore& semaphore_;
+    std::coroutine_handle<> handle_;
+};
+
+// Everything the philosopher coroutines of one run share
+struct CoroutineTable {
+    explicit CoroutineTable(DiningTable& table)
+        : table(table),
+          chopsticks(table.numPhilosophers, [&](int) { return table.placement.nodeFor(0, 1); }),
+          admissions(table.strategyKind == StrategyKind::Waiter
+                         ? std::make_unique<AsyncSemaphore>(table.numPhilosophers - 1)
+                         : nullptr) {}
+
+    DiningTable& table;
+    EventLoop loop;
+    NumaArray<AsyncSemaphore> chopsticks;  // On the node of the loop thread
+    std::unique_ptr<AsyncSemaphore> admissions;  // The waiter's N-1 seats, waiter strategy only
+};
+
+// Awaitable of pause(): suspends on the loop's timers unless there is nothing to wait for
+struct Pause {
+    EventLoop& loop;
+    std::chrono::nanoseconds duration;
+    bool spin;
+
+    bool await_ready() const { return spin || duration <= std::chrono::nanoseconds::zero(); }
+    void await_suspend(const std::coroutine_handle<> handle) {
+        loop.sleepUntil(Clock::now() + duration).await_suspend(handle);
+    }
+    void await_resume() const {}
+};
+
+/*
+    Function: pause
+    ---------------
+    Waits out a think or eat period drawn from the model: spin durations are real work and
+    run in place before the co_await and end early once the loop is stopped, sleeping ones
+    suspend on the loop's timers.
+*/
+Pause pause(EventLoop& loop, const DurationModel& model, std::mt19937_64& rng) {
+    const std::chrono::nanoseconds duration = model.sample(rng);
+    const bool spin = model.kind() == DurationModel::Kind::Spin;
+    if (spin) {
+        spinFor(duration, loop.stopToken());
+    }
+    return Pause{loop, duration, spin};
+}
+
+long long elapsedMs(const Clock::time_point since) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - since).count();
+}
+
+/*
+    Function: philosopherCoroutine
+    ------------------------------
+    The philosopher loop of philosopher.cpp, with every wait turned into a co_await.
+*/
+PhilosopherCoroutine philosopherCoroutine(CoroutineTable& shared, const int philosopherID) {
+    DiningTable& table = shared.table;
+    EventLoop& loop = shared.loop;
+    PhilosopherStats& stats = table.stats[philosopherID];
+    Seat seat = seatOf(table, philosopherID);
+    seat.stats = &stats;
+    const auto [first, second] = pickUpOrder(table.strategyKind, seat);
+    std::mt19937_64 rng(table.seed * 0x9e3779b97f4a7c15ULL + static_cast<std::uint64_t>(philosopherID));
+
+    while (true) {
+        logEvent(philosopherID, Event::Thinking);
+        const auto thinkingSince = Clock::now();
+        co_await pause(loop, table.thinkModels[philosopherID], rng);
+        logEvent(philosopherID, Event::Thought, -1, elapsedMs(thinkingSince));
+
+        logEvent(philosopherID, Event::Hungry);
+        const auto hungrySince = startHungryWait(stats);
+        if (shared.admissions != nullptr) {
+            co_await Acquire(loop, *shared.admissions);
+        }
+        for (const int chopstick : {first, second}) {
+            AsyncSemaphore& semaphore = shared.chopsticks[chopstick];
+            if (!semaphore.tryAcquire()) {
+                noteFailedTryAcquire(seat, chopstick);
+                noteBlockedOn(seat, chopstick);
+                co_await Acquire(loop, semaphore);
+            }
+            notePickedUp(seat, chopstick);
+        }
+        recordAcquisition(stats, hungrySince, Clock::now());
+
+        int courses = 0;
+        do {
+            logEvent(philosopherID, Event::Eating);
+            const auto eatingSince = Clock::now();
+            co_await pause(loop, table.eatModels[philosopherID], rng);
+            logEvent(philosopherID, Event::Ate, -1, elapsedMs(eatingSince));
+            bump(stats.meals);
+        } while (eatAnotherCourse(table, philosopherID, ++courses));
+
+        logEvent(philosopherID, Event::PutDown);  // Before a neighbour can pick up
+        shared.chopsticks[seat.left].release();
+        shared.chopsticks[seat.right].release();
+        if (shared.admissions != nullptr) {
+            shared.admissions->release();
+        }
+
+        if (table.mealLimit != 0 && stats.meals.load(std::memory_order_relaxed) >= table.mealLimit) {
+            table.finished.fetch_add(1, std::memory_order_release);
+            co_return;
+        }
+        co_await loop.yield();  // Let the neighbours just handed a chopstick run first
+    }
+}
+
+}  // namespace
+
+RunResult runPhilosopherCoroutines(DiningTable& table, const std::chrono::milliseconds duration) {
+    CoroutineTable shared(table);
+    std::vector<PhilosopherCoroutine> philosophers;
+    philosophers.reserve(table.numPhilosophers);
+    for (int i = 0; i < table.numPhilosophers; i++) {
+        philosophers.push_back(philosopherCoroutine(shared, i));
+        shared.loop.post(philosophers.back().handle());
+    }
+
+    const auto start = Clock::now();
+    {
+        std::jthread loopThread([&](const std::stop_token stop) {
+            if (table.placement.pinCurrentThread(0, 1)) {
+                table.pinned.fetch_add(1, std::memory_order_relaxed);
+            }
+            shared.loop.run(stop);
+        });
+        waitForRunEnd(table, start, duration);
+    }  // Stops and joins the loop; the coroutines are destroyed where they are suspended
+
+    RunResult result;
+    result.elapsed = Clock::now() - start;
+    result.workers = 1;
+    return result;
+}
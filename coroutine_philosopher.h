@@ -0,0 +1,26 @@
+/*
+    CoroutinePhilosopher
+    --------------------
+    The whole table on one thread: every philosopher is a C++20 coroutine driven by an
+    EventLoop (see event_loop.h).
+
+    think() and eat() are co_await-ed timers, and every chopstick is an awaitable: reaching
+    for a taken one links the coroutine into the chopstick's waiter list, and release() posts
+    it back to the loop holding the chopstick. No thread ever sleeps in sleep_for or blocks on
+    a semaphore, so the only context switches left are the loop's own idle sleeps.
+
+    Supports the same strategies as the pool executor: asymmetric, hierarchy and waiter.
+*/
+
+#pragma once
+
+#include "philosopher.h"
+
+#include <chrono>
+
+/*
+    Function: runPhilosopherCoroutines
+    ----------------------------------
+    Runs the table on a single event-loop thread until waitForRunEnd() returns.
+*/
+RunResult runPhilosopherCoroutines(DiningTable& table, std::chrono::milliseconds duration);
@@ -0,0 +1,25 @@
+/*
+    cpuRelax
+    --------
+    Spin-wait hint for busy loops: PAUSE on x86, YIELD on ARM, a scheduler yield elsewhere.
+    It lowers the power and memory-order-violation cost of spinning on a contended line and
+    gives the sibling hyper-thread the pipeline.
+*/
+
+#pragma once
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#else
+#include <thread>
+#endif
+
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    asm volatile("yield" ::: "memory");
+#else
+    std::this_thread::yield();
+#endif
+}
@@ -0,0 +1,153 @@
+#include "deadlock_detector.h"
+#include "duration.h"
+
+#include <algorithm>
+
+namespace {
+
+// Cycle members printed in a report before the rest is summarized
+constexpr std::size_t PRINTED_MEMBERS = 8;
+
+}  // namespace
+
+DeadlockDetector::DeadlockDetector(const DiningTable& table, const std::chrono::milliseconds interval)
+    : table_(table),
+      interval_(interval),
+      states_(table.numPhilosophers, 0),
+      owner_(table.numPhilosophers, -1),
+      visited_(table.numPhilosophers, 0) {
+    if (enabled()) {
+        thread_ = std::jthread([this](const std::stop_token stop) { run(stop); });
+    }
+}
+
+DeadlockDetector::~DeadlockDetector() {
+    stop();
+}
+
+void DeadlockDetector::stop() {
+    if (thread_.joinable()) {
+        thread_.request_stop();
+        thread_.join();
+    }
+}
+
+void DeadlockDetector::printSummary(std::FILE* out) const {
+    if (!enabled()) {
+        return;
+    }
+    std::fprintf(out, "Deadlock detector: %llu deadlock%s found (sampled every %lld ms)\n",
+                 static_cast<unsigned long long>(deadlocks_), deadlocks_ == 1 ? "" : "s",
+                 static_cast<long long>(interval_.count()));
+}
+
+void DeadlockDetector::run(const std::stop_token stop) {
+    while (!stop.stop_requested()) {
+        sleepFor(interval_, stop);
+        if (!stop.stop_requested()) {
+            sample();
+        }
+    }
+}
+
+void DeadlockDetector::sample() {
+    confirm();
+
+    // Apply the slots that changed to the owner table
+    for (int i = 0; i < table_.numPhilosophers; i++) {
+        const std::uint64_t word = table_.stats[i].waitState.load(std::memory_order_relaxed);
+        if (word == states_[i]) {
+            continue;
+        }
+        const WaitState previous = WaitState::unpack(states_[i]);
+        if (previous.held >= 0 && owner_[previous.held] == i) {
+            owner_[previous.held] = -1;
+        }
+        const WaitState current = WaitState::unpack(word);
+        if (current.held >= 0) {
+            owner_[current.held] = i;
+        }
+        states_[i] = word;
+    }
+    findCycles();
+}
+
+void DeadlockDetector::findCycles() {
+    const auto next = [this](const int philosopher) {
+        const int waiting = WaitState::unpack(states_[philosopher]).waiting;
+        if (waiting < 0) {
+            return -1;
+        }
+        const int holder = owner_[waiting];
+        return holder == philosopher ? -1 : holder;
+    };
+
+    // Every philosopher is walked at most once per sample: a walk ends at a philosopher that
+    // is not blocked, at one an earlier walk of this sample visited, or on its own path
+    const std::uint64_t firstWalk = walks_ + 1;
+    for (int start = 0; start < table_.numPhilosophers; start++) {
+        if (states_[start] == 0 || visited_[start] >= firstWalk) {
+            continue;
+        }
+        const std::uint64_t walk = ++walks_;
+        int at = start;
+        while (at >= 0 && visited_[at] < firstWalk) {
+            visited_[at] = walk;
+            at = next(at);
+        }
+        if (at < 0 || visited_[at] != walk) {
+            continue;
+        }
+        std::vector<Member> cycle;
+        int member = at;
+        do {
+            cycle.push_back(Member{member, states_[member], table_.stats[member].meals.load(std::memory_order_relaxed)});
+            member = next(member);
+        } while (member != at);
+        candidates_.push_back(std::move(cycle));
+    }
+}
+
+void DeadlockDetector::confirm() {
+    for (const std::vector<Member>& cycle : candidates_) {
+        const bool unchanged = std::all_of(cycle.begin(), cycle.end(), [this](const Member& member) {
+            const PhilosopherStats& stats = table_.stats[member.philosopher];
+            return stats.waitState.load(std::memory_order_relaxed) == member.waitState &&
+                   stats.meals.load(std::memory_order_relaxed) == member.meals;
+        });
+        if (unchanged) {
+            report(cycle);
+        }
+    }
+    candidates_.clear();
+}
+
+void DeadlockDetector::report(const std::vector<Member>& cycle) {
+    const auto smallest = std::min_element(cycle.begin(), cycle.end(), [](const Member& a, const Member& b) {
+        return a.philosopher < b.philosopher;
+    });
+    if (std::find(reported_.begin(), reported_.end(), smallest->philosopher) != reported_.end()) {
+        return;
+    }
+    reported_.push_back(smallest->philosopher);
+    deadlocks_++;
+
+    // Printed from the smallest member on, in wait-for order
+    std::vector<Member> ordered(smallest, cycle.end());
+    ordered.insert(ordered.end(), cycle.begin(), smallest);
+    if (firstCycle_.empty()) {
+        for (const Member& member : ordered) {
+            firstCycle_.push_back(member.philosopher);
+        }
+    }
+
+    std::fprintf(stderr, "Deadlock: %zu philosophers in a wait-for cycle:", ordered.size());
+    for (std::size_t i = 0; i < ordered.size() && i < PRINTED_MEMBERS; i++) {
+        const WaitState state = WaitState::unpack(ordered[i].waitState);
+        std::fprintf(stderr, " %d (holds %d, waits for %d) ->", ordered[i].philosopher, state.held, state.waiting);
+    }
+    if (ordered.size() > PRINTED_MEMBERS) {
+        std::fprintf(stderr, " ... %zu more ->", ordered.size() - PRINTED_MEMBERS);
+    }
+    std::fprintf(stderr, " %d\n", ordered.front().philosopher);
+}
@@ -0,0 +1,81 @@
+/*
+    DeadlockDetector
+    ----------------
+    Background detector of wait-for cycles. A philosopher about to block on a chopstick
+    publishes what it holds and what it waits for in its PhilosopherStats::waitState slot (one
+    relaxed store, see WaitState) and clears the slot once it holds both. Uncontended pickups
+    publish nothing.
+
+    Every interval the detector reads all slots. Slots that changed since the last sample
+    update its chopstick owner table, so the wait-for graph is maintained incrementally: an
+    edge runs from each blocked philosopher to the philosopher holding the chopstick it waits
+    for. Every philosopher waits for at most one chopstick, so each has at most one outgoing
+    edge and a walk along the edges finds all cycles in O(N).
+
+    The slots are read one after another while the philosophers run, so a cycle in one
+    sample may be an artefact of the reading order. A cycle is therefore reported only when
+    the next sample finds every member in the same state with the same meal count: a real
+    deadlock never changes. Reports go to stderr, once per cycle.
+*/
+
+#pragma once
+
+#include "philosopher.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+class DeadlockDetector {
+public:
+    // Does nothing if the interval is zero
+    DeadlockDetector(const DiningTable& table, std::chrono::milliseconds interval);
+    ~DeadlockDetector();
+
+    DeadlockDetector(const DeadlockDetector&) = delete;
+    DeadlockDetector& operator=(const DeadlockDetector&) = delete;
+
+    bool enabled() const { return interval_.count() > 0; }
+
+    // Stops the detector thread; the results below are final afterwards
+    void stop();
+
+    std::chrono::milliseconds interval() const { return interval_; }
+
+    // Deadlocks confirmed so far
+    std::uint64_t deadlocks() const { return deadlocks_; }
+
+    // Philosophers of the first confirmed cycle, in wait-for order
+    const std::vector<int>& firstCycle() const { return firstCycle_; }
+
+    // One-line summary
+    void printSummary(std::FILE* out) const;
+
+private:
+    struct Member {
+        int philosopher;
+        std::uint64_t waitState;
+        std::uint64_t meals;
+    };
+
+    void run(std::stop_token stop);
+    void sample();
+    void findCycles();
+    void confirm();
+    void report(const std::vector<Member>& cycle);
+
+    const DiningTable& table_;
+    const std::chrono::milliseconds interval_;
+    std::vector<std::uint64_t> states_;  // waitState of every philosopher at the last sample
+    std::vector<int> owner_;             // Blocked philosopher holding each chopstick, -1 if none
+    std::vector<std::uint64_t> visited_;  // Walk that last visited each philosopher
+    std::uint64_t walks_ = 0;
+    std::vector<std::vector<Member>> candidates_;  // Cycles of the last sample, to confirm
+    std::vector<int> reported_;                    // Smallest member of every reported cycle
+    std::uint64_t deadlocks_ = 0;
+    std::vector<int> firstCycle_;
+    std::jthread thread_;
+};
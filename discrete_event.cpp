@@ -0,0 +1,250 @@
+#include "discrete_event.h"
+
+#include <tuple>
+
+DiscreteEventSimulation::DiscreteEventSimulation(DiningTable& table)
+    : table_(table),
+      philosophers_(table.numPhilosophers),
+      holders_(table.numPhilosophers, FREE),
+      waiters_(table.numPhilosophers),
+      admissions_(table.numPhilosophers - 1) {
+    for (int i = 0; i < table.numPhilosophers; i++) {
+        Philosopher& philosopher = philosophers_[i];
+        philosopher.rng.seed(table.seed * 0x9e3779b97f4a7c15ULL + static_cast<std::uint64_t>(i));
+        std::tie(philosopher.first, philosopher.second) = pickUpOrder(table.strategyKind, seatOf(table, i));
+    }
+    if (table.strategyKind == StrategyKind::ChandyMisra) {
+        // Fork i lies between philosophers i - 1 and i; fork 0 between N - 1 and 0
+        forks_.resize(table.numPhilosophers);
+        for (int i = 0; i < table.numPhilosophers; i++) {
+            forks_[i].owner = i == 0 ? 0 : i - 1;
+        }
+    }
+    for (int i = 0; i < table.numPhilosophers; i++) {
+        startThinking(i);
+    }
+}
+
+void DiscreteEventSimulation::run(const std::chrono::nanoseconds limit) {
+    const bool timed = limit > std::chrono::nanoseconds::zero();
+    while (!queue_.empty()) {
+        const Event event = queue_.top();
+        if (timed && event.time > limit) {
+            now_ = limit;
+            return;
+        }
+        queue_.pop();
+        now_ = event.time;
+        events_++;
+        switch (event.kind) {
+            case EventKind::Thought:
+                becomeHungry(event.philosopher);
+                break;
+            case EventKind::Ate:
+                finishEating(event.philosopher);
+                break;
+        }
+    }
+}
+
+void DiscreteEventSimulation::schedule(const std::chrono::nanoseconds time, const int philosopher,
+                                       const EventKind kind) {
+    queue_.push(Event{time, sequence_++, philosopher, kind});
+}
+
+std::chrono::steady_clock::time_point DiscreteEventSimulation::at(const std::chrono::nanoseconds time) const {
+    return std::chrono::steady_clock::time_point(std::chrono::duration_cast<std::chrono::steady_clock::duration>(time));
+}
+
+void DiscreteEventSimulation::startThinking(const int id) {
+    schedule(now_ + table_.thinkModels[id].sample(philosophers_[id].rng), id, EventKind::Thought);
+}
+
+void DiscreteEventSimulation::becomeHungry(const int id) {
+    Philosopher& philosopher = philosophers_[id];
+    philosopher.hungry = true;
+    philosopher.hungrySince = now_;
+
+    switch (table_.strategyKind) {
+        case StrategyKind::Asymmetric:
+        case StrategyKind::Hierarchy:
+        case StrategyKind::Naive:
+        case StrategyKind::Backoff:  // Rejected by the config: its timeouts are wall-clock
+        case StrategyKind::Arbiter:  // Rejected by the config as well
+            pickUpNext(id);
+            break;
+        case StrategyKind::Waiter:
+            admit(id);
+            break;
+        case StrategyKind::ChandyMisra:
+            requestForks(id);
+            break;
+        case StrategyKind::CasBitmap:
+            tryTakeBoth(id);
+            break;
+    }
+}
+
+void DiscreteEventSimulation::startEating(const int id) {
+    Philosopher& philosopher = philosophers_[id];
+    philosopher.hungry = false;
+    recordAcquisition(table_.stats[id], at(philosopher.hungrySince), at(now_));
+    schedule(now_ + table_.eatModels[id].sample(philosopher.rng), id, EventKind::Ate);
+}
+
+void DiscreteEventSimulation::finishEating(const int id) {
+    const Seat seat = seatOf(table_, id);
+
+    switch (table_.strategyKind) {
+        case StrategyKind::Asymmetric:
+        case StrategyKind::Hierarchy:
+        case StrategyKind::Waiter:
+        case StrategyKind::Naive:
+        case StrategyKind::Backoff:
+        case StrategyKind::Arbiter:
+            philosophers_[id].held = 0;
+            putDownChopstick(seat.left);
+            putDownChopstick(seat.right);
+            if (table_.strategyKind == StrategyKind::Waiter) {
+                if (admissionQueue_.empty()) {
+                    admissions_++;
+                } else {
+                    // The seat passes straight to the longest-waiting philosopher
+                    const int next = admissionQueue_.front();
+                    admissionQueue_.pop_front();
+                    pickUpNext(next);
+                }
+            }
+            break;
+
+        case StrategyKind::ChandyMisra:
+            for (const int index : {seat.left, seat.right}) {
+                forks_[index].dirty = true;
+                forks_[index].inUse = false;
+            }
+            for (const int index : {seat.left, seat.right}) {
+                const int requester = forks_[index].requester;
+                if (requester != -1 && requester != id) {
+                    forks_[index].requester = -1;
+                    requestForks(requester);
+                }
+            }
+            break;
+
+        case StrategyKind::CasBitmap: {
+            holders_[seat.left] = FREE;
+            holders_[seat.right] = FREE;
+            // Both neighbours retry, as their CAS loops would after the release
+            const int leftNeighbour = (id + table_.numPhilosophers - 1) % table_.numPhilosophers;
+            const int rightNeighbour = (id + 1) % table_.numPhilosophers;
+            for (const int neighbour : {leftNeighbour, rightNeighbour}) {
+                if (philosophers_[neighbour].hungry) {
+                    tryTakeBoth(neighbour);
+                }
+                if (leftNeighbour == rightNeighbour) {
+                    break;  // Two seats: both sides are the same philosopher
+                }
+            }
+            break;
+        }
+    }
+
+    PhilosopherStats& stats = table_.stats[id];
+    bump(stats.meals);
+    if (table_.mealLimit != 0 && stats.meals.load(std::memory_order_relaxed) >= table_.mealLimit) {
+        table_.finished.fetch_add(1, std::memory_order_relaxed);
+        return;  // Leaves the table: no further events for this philosopher
+    }
+    startThinking(id);
+}
+
+void DiscreteEventSimulation::notePickedUp(const int id) {
+    PhilosopherStats& stats = table_.stats[id];
+    if (stats.chopsticksHeld++ == 0) {
+        stats.firstPickedUp = at(now_);
+    }
+}
+
+void DiscreteEventSimulation::pickUpNext(const int id) {
+    Philosopher& philosopher = philosophers_[id];
+    while (philosopher.held < 2) {
+        const int chopstick = philosopher.held == 0 ? philosopher.first : philosopher.second;
+        if (holders_[chopstick] != FREE) {
+            bump(table_.stats[id].failedTryAcquires);
+            waiters_[chopstick].push_back(id);
+            return;
+        }
+        holders_[chopstick] = id;
+        philosopher.held++;
+        notePickedUp(id);
+    }
+    startEating(id);
+}
+
+void DiscreteEventSimulation::putDownChopstick(const int chopstick) {
+    std::deque<int>& waiting = waiters_[chopstick];
+    if (waiting.empty()) {
+        holders_[chopstick] = FREE;
+        return;
+    }
+    // Handed straight to the oldest waiter, who then reaches for its next chopstick
+    const int next = waiting.front();
+    waiting.pop_front();
+    holders_[chopstick] = next;
+    philosophers_[next].held++;
+    notePickedUp(next);
+    pickUpNext(next);
+}
+
+void DiscreteEventSimulation::admit(const int id) {
+    if (admissions_ == 0) {
+        admissionQueue_.push_back(id);
+        return;
+    }
+    admissions_--;
+    pickUpNext(id);
+}
+
+void DiscreteEventSimulation::requestForks(const int id) {
+    const Seat seat = seatOf(table_, id);
+    for (const int index : {seat.left, seat.right}) {
+        Fork& fork = forks_[index];
+        if (fork.owner == id) {
+            continue;
+        }
+        if (!fork.dirty || fork.inUse) {
+            // Clean forks are kept until their owner has eaten
+            bump(table_.stats[id].failedTryAcquires);
+            fork.requester = id;
+            continue;
+        }
+        // Granted: the fork is cleaned on the way, and a hungry previous owner asks for it back
+        const int previous = fork.owner;
+        fork.owner = id;
+        fork.dirty = false;
+        fork.requester = philosophers_[previous].hungry ? previous : -1;
+    }
+
+    Fork& left = forks_[seat.left];
+    Fork& right = forks_[seat.right];
+    if (left.owner == id && right.owner == id) {
+        left.inUse = true;
+        right.inUse = true;
+        notePickedUp(id);
+        notePickedUp(id);
+        startEating(id);
+    }
+}
+
+void DiscreteEventSimulation::tryTakeBoth(const int id) {
+    const Seat seat = seatOf(table_, id);
+    if (holders_[seat.left] != FREE || holders_[seat.right] != FREE) {
+        bump(table_.stats[id].failedTryAcquires);
+        return;
+    }
+    holders_[seat.left] = id;
+    holders_[seat.right] = id;
+    notePickedUp(id);
+    notePickedUp(id);
+    startEating(id);
+}
@@ -0,0 +1,118 @@
+/*
+    DiscreteEventSimulation
+    -----------------------
+    Deterministic simulation of the table in virtual time, on a single thread.
+
+    Thinking and eating do not sleep: they schedule an "ate" or "thought" event at the
+    virtual time the period ends, and the simulation jumps from event to event. Chopstick
+    contention is resolved at the instant a philosopher becomes hungry or a neighbour puts a
+    chopstick down, following the protocol of the selected strategy:
+    - asymmetric, hierarchy, naive: chopsticks taken one at a time in the strategy's order;
+      a taken chopstick queues the philosopher, and the release hands it to the oldest
+      waiter. A naive table that deadlocks runs out of events and ends early.
+    - waiter: the same with left-then-right order, behind a FIFO admission of N-1 seats.
+    - chandy-misra: dirty/clean forks; a request is granted when the fork is dirty and its
+      owner is not eating, otherwise the requester waits for the owner's meal to end.
+    - cas-bitmap: both forks taken at once or none; a waiting philosopher retries whenever a
+      neighbour puts its forks down, with no queue, as after a failed CAS.
+    Events at the same virtual time are processed in the order they were scheduled, so a run
+    is fully determined by the configuration and the seed.
+*/
+
+#pragma once
+
+#include "philosopher.h"
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <queue>
+#include <random>
+#include <vector>
+
+class DiscreteEventSimulation {
+public:
+    explicit DiscreteEventSimulation(DiningTable& table);
+
+    /*
+        Function: run
+        -------------
+        Processes events until virtual time passes the limit (zero means no limit) or no
+        event is left, i.e. every philosopher reached the meal limit.
+    */
+    void run(std::chrono::nanoseconds limit);
+
+    // Virtual time reached
+    std::chrono::nanoseconds now() const { return now_; }
+
+    // Events processed so far
+    std::uint64_t events() const { return events_; }
+
+private:
+    enum class EventKind : std::uint8_t {
+        Thought,  // Thinking period over; the philosopher becomes hungry
+        Ate       // Meal over; the philosopher puts its chopsticks down
+    };
+
+    struct Event {
+        std::chrono::nanoseconds time;
+        std::uint64_t sequence;  // Tie-breaker: events at the same time run in scheduling order
+        int philosopher;
+        EventKind kind;
+
+        bool operator>(const Event& other) const {
+            return time != other.time ? time > other.time : sequence > other.sequence;
+        }
+    };
+
+    struct Philosopher {
+        std::mt19937_64 rng;
+        int first = 0;    // Pick-up order of the ordering strategies
+        int second = 0;
+        int held = 0;     // Chopsticks held by the ordering strategies
+        bool hungry = false;
+        std::chrono::nanoseconds hungrySince{0};
+    };
+
+    // Fork state of Chandy-Misra
+    struct Fork {
+        int owner = 0;
+        bool dirty = true;
+        bool inUse = false;
+        int requester = -1;  // Hungry neighbour waiting for this fork
+    };
+
+    static constexpr int FREE = -1;
+
+    void schedule(std::chrono::nanoseconds time, int philosopher, EventKind kind);
+    std::chrono::steady_clock::time_point at(std::chrono::nanoseconds time) const;
+
+    void startThinking(int id);
+    void becomeHungry(int id);
+    void startEating(int id);
+    void finishEating(int id);
+    void notePickedUp(int id);
+
+    // Ordering strategies: asymmetric, hierarchy and waiter
+    void pickUpNext(int id);
+    void putDownChopstick(int chopstick);
+    void admit(int id);
+
+    // Chandy-Misra
+    void requestForks(int id);
+
+    // CAS bitmap
+    void tryTakeBoth(int id);
+
+    DiningTable& table_;
+    std::vector<Philosopher> philosophers_;
+    std::vector<int> holders_;                  // Philosopher holding each chopstick, or FREE
+    std::vector<std::deque<int>> waiters_;      // FIFO of philosophers waiting for each chopstick
+    long admissions_ = 0;                       // Free waiter seats
+    std::deque<int> admissionQueue_;
+    std::vector<Fork> forks_;
+    std::priority_queue<Event, std::vector<Event>, std::greater<>> queue_;
+    std::chrono::nanoseconds now_{0};
+    std::uint64_t sequence_ = 0;
+    std::uint64_t events_ = 0;
+};
@@ -0,0 +1,177 @@
+#include "duration.h"
+
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::vector<std::string> splitSpec(const std::string& spec) {
+    std::vector<std::string> parts;
+    std::size_t begin = 0;
+    while (true) {
+        const std::size_t colon = spec.find(':', begin);
+        parts.push_back(spec.substr(begin, colon - begin));
+        if (colon == std::string::npos) {
+            break;
+        }
+        begin = colon + 1;
+    }
+    return parts;
+}
+
+}  // namespace
+
+std::chrono::nanoseconds parseDuration(const std::string& text) {
+    std::size_t consumed = 0;
+    double amount = 0;
+    try {
+        amount = std::stod(text, &consumed);
+    } catch (const std::exception&) {
+        consumed = 0;
+    }
+    // stod() also reads "nan" and "inf", which have no nanosecond count
+    if (consumed == 0 || !std::isfinite(amount) || amount < 0) {
+        throw std::invalid_argument("invalid duration '" + text + "'");
+    }
+
+    const std::string unit = text.substr(consumed);
+    double scale = 0;
+    if (unit == "ns") {
+        scale = 1;
+    } else if (unit == "us") {
+        scale = 1e3;
+    } else if (unit == "ms" || unit.empty()) {
+        scale = 1e6;
+    } else if (unit == "s") {
+        scale = 1e9;
+    } else {
+        throw std::invalid_argument("unknown duration unit in '" + text + "'");
+    }
+    // 2^63 ns is about 292 years; anything longer does not fit the count
+    if (amount * scale >= 9.2e18) {
+        throw std::invalid_argument("duration '" + text + "' is too long");
+    }
+    return std::chrono::nanoseconds(static_cast<std::int64_t>(amount * scale));
+}
+
+DurationModel::DurationModel(const std::chrono::nanoseconds duration) : first_(duration) {}
+
+DurationModel DurationModel::parse(const std::string& spec) {
+    const std::vector<std::string> parts = splitSpec(spec);
+    DurationModel model;
+
+    if (parts.size() == 1) {
+        model.first_ = parseDuration(parts[0]);
+        return model;
+    }
+
+    const std::string& kind = parts[0];
+    if (kind == "constant" && parts.size() == 2) {
+        model.kind_ = Kind::Constant;
+        model.first_ = parseDuration(parts[1]);
+    } else if (kind == "uniform" && parts.size() == 3) {
+        model.kind_ = Kind::Uniform;
+        model.first_ = parseDuration(parts[1]);
+        model.second_ = parseDuration(parts[2]);
+        if (model.second_ < model.first_) {
+            throw std::invalid_argument("uniform maximum is below its minimum in '" + spec + "'");
+        }
+    } else if ((kind == "exp" || kind == "exponential") && parts.size() == 2) {
+        model.kind_ = Kind::Exponential;
+        model.first_ = parseDuration(parts[1]);
+    } else if (kind == "spin" && parts.size() == 2) {
+        model.kind_ = Kind::Spin;
+        model.first_ = parseDuration(parts[1]);
+    } else {
+        throw std::invalid_argument("invalid duration spec '" + spec + "'");
+    }
+    return model;
+}
+
+std::chrono::nanoseconds DurationModel::sample(std::mt19937_64& rng) const {
+    switch (kind_) {
+        case Kind::Constant:
+        case Kind::Spin:
+            return first_;
+        case Kind::Uniform: {
+            std::uniform_int_distribution<std::int64_t> distribution(first_.count(), second_.count());
+            return std::chrono::nanoseconds(distribution(rng));
+        }
+        case Kind::Exponential: {
+            if (first_.count() == 0) {
+                return first_;
+            }
+            std::exponential_distribution<double> distribution(1.0 / static_cast<double>(first_.count()));
+            return std::chrono::nanoseconds(static_cast<std::int64_t>(distribution(rng)));
+        }
+    }
+    return first_;
+}
+
+std::chrono::nanoseconds DurationModel::apply(std::mt19937_64& rng, const std::stop_token& stop) const {
+    const std::chrono::nanoseconds duration = sample(rng);
+    if (kind_ == Kind::Spin) {
+        spinFor(duration, stop);
+    } else {
+        sleepFor(duration, stop);
+    }
+    return duration;
+}
+
+std::chrono::nanoseconds DurationModel::mean() const {
+    if (kind_ == Kind::Uniform) {
+        return (first_ + second_) / 2;
+    }
+    return first_;
+}
+
+std::string DurationModel::describe() const {
+    const std::string first = std::to_string(first_.count()) + "ns";
+    switch (kind_) {
+        case Kind::Constant:
+            return "constant:" + first;
+        case Kind::Uniform:
+            return "uniform:" + first + ":" + std::to_string(second_.count()) + "ns";
+        case Kind::Exponential:
+            return "exp:" + first;
+        case Kind::Spin:
+            return "spin:" + first;
+    }
+    return first;
+}
+
+void spinFor(const std::chrono::nanoseconds duration, const std::stop_token& stop) {
+    const auto deadline = std::chrono::steady_clock::now() + duration;
+    // The running hash keeps the loop doing arithmetic the optimizer cannot drop
+    volatile std::uint64_t sink = 0;
+    std::uint64_t hash = 0x9e3779b97f4a7c15ULL;
+    while (std::chrono::steady_clock::now() < deadline && !stop.stop_requested()) {
+        for (int i = 0; i < 16; i++) {
+            hash ^= hash >> 33;
+            hash *= 0xff51afd7ed558ccdULL;
+        }
+    }
+    sink = hash;
+    (void)sink;
+}
+
+void sleepFor(const std::chrono::nanoseconds duration, const std::stop_token& stop) {
+    if (duration <= std::chrono::nanoseconds::zero()) {
+        return;
+    }
+    if (!stop.stop_possible()) {
+        std::this_thread::sleep_for(duration);
+        return;
+    }
+    // A condition variable that is never notified: the wait only ends on timeout or stop.
+    // Per thread, as libstdc++ allocates the internal mutex of every condition_variable_any.
+    thread_local std::mutex mutex;
+    thread_local std::condition_variable_any wakeUp;
+    std::unique_lock<std::mutex> lock(mutex);
+    wakeUp.wait_for(lock, stop, duration, [] { return false; });
+}
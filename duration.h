@@ -0,0 +1,85 @@
+/*
+    DurationModel
+    -------------
+    Distribution of the time a philosopher spends thinking or eating.
+
+    Specs are written as KIND:ARGS, with every duration carrying a unit (ns, us, ms, s;
+    a bare number means milliseconds):
+    - constant:3ms        always 3 ms (a bare duration such as "3ms" is shorthand for this)
+    - uniform:1ms:5ms     uniformly distributed between 1 ms and 5 ms
+    - exp:2ms             exponentially distributed with a mean of 2 ms
+    - spin:500ns          busy-spin for 500 ns doing real CPU work instead of sleeping
+    The sleeping kinds go through std::this_thread::sleep_for; spin keeps the core busy, so
+    contention can be studied at timescales far below the scheduler's sleep granularity.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <random>
+#include <stop_token>
+#include <string>
+
+class DurationModel {
+public:
+    enum class Kind {
+        Constant,
+        Uniform,
+        Exponential,
+        Spin
+    };
+
+    DurationModel() = default;
+
+    // Constant model
+    explicit DurationModel(std::chrono::nanoseconds duration);
+
+    /*
+        Function: parse
+        ---------------
+        Parses a spec as described above. Throws std::invalid_argument when malformed.
+    */
+    static DurationModel parse(const std::string& spec);
+
+    // Draws the next duration
+    std::chrono::nanoseconds sample(std::mt19937_64& rng) const;
+
+    // Draws a duration and waits for it: sleeping, or spinning for the spin kind. The wait
+    // ends early when a stop is requested on the token.
+    std::chrono::nanoseconds apply(std::mt19937_64& rng, const std::stop_token& stop = {}) const;
+
+    Kind kind() const { return kind_; }
+
+    // Mean of the distribution
+    std::chrono::nanoseconds mean() const;
+
+    // Canonical spec, e.g. "uniform:1000000ns:5000000ns"
+    std::string describe() const;
+
+private:
+    Kind kind_ = Kind::Constant;
+    std::chrono::nanoseconds first_{0};   // Constant/spin duration, uniform minimum or exponential mean
+    std::chrono::nanoseconds second_{0};  // Uniform maximum
+};
+
+/*
+    Function: spinFor
+    -----------------
+    Busy-waits for the given duration, or until a stop is requested on the token.
+*/
+void spinFor(std::chrono::nanoseconds duration, const std::stop_token& stop = {});
+
+/*
+    Function: sleepFor
+    ------------------
+    Sleeps for the given duration, or until a stop is requested on the token.
+*/
+void sleepFor(std::chrono::nanoseconds duration, const std::stop_token& stop = {});
+
+/*
+    Function: parseDuration
+    -----------------------
+    Parses a single duration such as "250us". Throws std::invalid_argument when malformed,
+    not finite or too long for a nanosecond count.
+*/
+std::chrono::nanoseconds parseDuration(const std::string& text);
@@ -0,0 +1,28 @@
+#include "event_loop.h"
+#include "duration.h"
+
+#include <chrono>
+#include <optional>
+
+void EventLoop::run(const std::stop_token& stop) {
+    constexpr auto IDLE_LIMIT = std::chrono::milliseconds(100);  // Nothing scheduled at all
+
+    stop_ = stop;
+    while (!stop.stop_requested()) {
+        const Clock::time_point now = Clock::now();
+        timers_.advance(now, [this](const std::coroutine_handle<> handle) { ready_.push_back(handle); });
+
+        if (ready_.empty()) {
+            const std::optional<Clock::time_point> next = timers_.nextWakeUp();
+            sleepFor(next ? *next - now : IDLE_LIMIT, stop);
+            continue;
+        }
+
+        // Resume only what is ready now, so timers are fired between batches
+        for (std::size_t batch = ready_.size(); batch > 0 && !stop.stop_requested(); batch--) {
+            const std::coroutine_handle<> handle = ready_.front();
+            ready_.pop_front();
+            handle.resume();
+        }
+    }
+}
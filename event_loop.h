@@ -0,0 +1,66 @@
+/*
+    EventLoop
+    ---------
+    Single-threaded scheduler of coroutines: a FIFO of ready coroutine handles and a
+    hierarchical timer wheel of sleeping ones (see timer_wheel.h). Every member is called
+    from the loop thread only (coroutines it resumes post and sleep from there too), so the
+    loop itself needs no synchronization.
+*/
+
+#pragma once
+
+#include "timer_wheel.h"
+
+#include <chrono>
+#include <coroutine>
+#include <deque>
+#include <stop_token>
+
+class EventLoop {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Queues a suspended coroutine to be resumed
+    void post(std::coroutine_handle<> handle) { ready_.push_back(handle); }
+
+    // Awaitable that resumes the coroutine once the deadline has passed
+    auto sleepUntil(const Clock::time_point deadline) {
+        struct Awaiter {
+            EventLoop& loop;
+            Clock::time_point deadline;
+
+            bool await_ready() const { return false; }
+            void await_suspend(const std::coroutine_handle<> handle) { loop.timers_.schedule(deadline, handle); }
+            void await_resume() const {}
+        };
+        return Awaiter{*this, deadline};
+    }
+
+    // Awaitable that moves the coroutine to the back of the ready queue
+    auto yield() {
+        struct Awaiter {
+            EventLoop& loop;
+
+            bool await_ready() const { return false; }
+            void await_suspend(const std::coroutine_handle<> handle) { loop.post(handle); }
+            void await_resume() const {}
+        };
+        return Awaiter{*this};
+    }
+
+    /*
+        Function: run
+        -------------
+        Resumes ready coroutines and fires due timers until a stop is requested. With nothing
+        ready the thread sleeps until the wheel's next wake-up.
+    */
+    void run(const std::stop_token& stop);
+
+    // Stop token of the current run(), for work done in place on the loop thread
+    const std::stop_token& stopToken() const { return stop_; }
+
+private:
+    std::stop_token stop_;
+    std::deque<std::coroutine_handle<>> ready_;
+    TimerWheel<std::coroutine_handle<>> timers_;
+};
@@ -0,0 +1,155 @@
+/*
+    ForkBitmap
+    ----------
+    Fork table packed 64 forks per atomic 64-bit word, one bit per fork (1 = taken).
+
+    A philosopher whose two forks live in the same word takes both with a single
+    compare-and-swap, so it never holds one fork while waiting for the other. Only a seat whose
+    pair straddles a word boundary (fork 63 and 64 of a word pair, or the last seat wrapping
+    around to fork 0 on tables larger than 64) needs two CASes; it takes the lower-numbered
+    fork first, and since every other seat acquires atomically, that ordering alone rules out
+    a wait-for cycle.
+
+    Waiters spin with bounded exponential backoff and then park on the word's release
+    sequence (an event count), which releasers only bump while someone is parked. A stop
+    request bumps the sequence as well, so parked waiters can give up.
+*/
+
+#pragma once
+
+#include "cache_line.h"
+#include "cpu_relax.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <stop_token>
+
+class ForkBitmap {
+public:
+    static constexpr int MAX_BACKOFF = 64;  // cpuRelax() hints in the last spin round
+
+    explicit ForkBitmap(const int numForks)
+        : words_(std::make_unique<Word[]>(static_cast<std::size_t>(numForks + 63) / 64)) {}
+
+    // Blocks until both forks are held
+    void acquirePair(const int a, const int b) {
+        acquirePair(a, b, std::stop_token{});
+    }
+
+    // Blocks until both forks are held (true) or a stop is requested (false, nothing held)
+    bool acquirePair(const int a, const int b, const std::stop_token& stop) {
+        const int low = std::min(a, b);
+        const int high = std::max(a, b);
+        if (low / 64 == high / 64) {
+            return acquireBits(words_[low / 64], bit(low) | bit(high), stop);
+        }
+        if (!acquireBits(words_[low / 64], bit(low), stop)) {
+            return false;
+        }
+        if (!acquireBits(words_[high / 64], bit(high), stop)) {
+            releaseBits(words_[low / 64], bit(low));
+            return false;
+        }
+        return true;
+    }
+
+    // Takes both forks only if both are free right now
+    bool tryAcquirePair(const int a, const int b) {
+        const int low = std::min(a, b);
+        const int high = std::max(a, b);
+        if (low / 64 == high / 64) {
+            return tryAcquireBits(words_[low / 64], bit(low) | bit(high));
+        }
+        if (!tryAcquireBits(words_[low / 64], bit(low))) {
+            return false;
+        }
+        if (!tryAcquireBits(words_[high / 64], bit(high))) {
+            releaseBits(words_[low / 64], bit(low));
+            return false;
+        }
+        return true;
+    }
+
+    void releasePair(const int a, const int b) {
+        if (a / 64 == b / 64) {
+            releaseBits(words_[a / 64], bit(a) | bit(b));
+        } else {
+            releaseBits(words_[a / 64], bit(a));
+            releaseBits(words_[b / 64], bit(b));
+        }
+    }
+
+private:
+    struct alignas(CACHE_LINE_SIZE) Word {
+        std::atomic<std::uint64_t> bits{0};
+        std::atomic<std::uint32_t> sequence{0};  // Bumped on release while waiters are parked
+        std::atomic<std::uint32_t> parked{0};    // Number of parked waiters
+    };
+
+    // Stop callback: wakes the waiters parked on a word
+    struct WakeParked {
+        Word* word;
+        void operator()() const {
+            word->sequence.fetch_add(1);
+            word->sequence.notify_all();
+        }
+    };
+
+    static std::uint64_t bit(const int fork) { return std::uint64_t{1} << (fork % 64); }
+
+    static bool tryAcquireBits(Word& word, const std::uint64_t mask) {
+        std::uint64_t current = word.bits.load(std::memory_order_relaxed);
+        while ((current & mask) == 0) {
+            if (word.bits.compare_exchange_weak(current, current | mask, std::memory_order_acquire,
+                                                std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static bool acquireBits(Word& word, const std::uint64_t mask, const std::stop_token& stop) {
+        for (int backoff = 1; backoff <= MAX_BACKOFF; backoff *= 2) {
+            if (tryAcquireBits(word, mask)) {
+                return true;
+            }
+            for (int i = 0; i < backoff; i++) {
+                cpuRelax();
+            }
+        }
+
+        std::optional<std::stop_callback<WakeParked>> wakeOnStop;
+        wakeOnStop.emplace(stop, WakeParked{&word});
+        while (true) {
+            // Announce the waiter before sampling the sequence, then re-check the bits, so a
+            // release either sees the waiter and bumps the sequence or is seen by the re-check
+            word.parked.fetch_add(1);
+            const std::uint32_t sequence = word.sequence.load();
+            const bool free = (word.bits.load() & mask) == 0;
+            if (!free && !stop.stop_requested()) {
+                word.sequence.wait(sequence);
+            }
+            word.parked.fetch_sub(1);
+
+            if (tryAcquireBits(word, mask)) {
+                return true;
+            }
+            if (stop.stop_requested()) {
+                return false;
+            }
+        }
+    }
+
+    static void releaseBits(Word& word, const std::uint64_t mask) {
+        word.bits.fetch_and(~mask);
+        if (word.parked.load() != 0) {
+            word.sequence.fetch_add(1);
+            word.sequence.notify_all();
+        }
+    }
+
+    std::unique_ptr<Word[]> words_;
+};
@@ -0,0 +1,171 @@
+/*
+    JsonWriter
+    ----------
+    Minimal streaming JSON writer for machine-readable reports. Commas and indentation are
+    inserted automatically; the caller is responsible for balancing begin/end calls.
+    Doubles that are not finite, e.g. a rate over a zero-length run, are written as null,
+    since JSON has no NaN or infinity.
+*/
+
+#pragma once
+
+#include "metrics.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <ostream>
+#include <string>
+#include <vector>
+
+class JsonWriter {
+public:
+    explicit JsonWriter(std::ostream& out) : out_(out) {}
+
+    JsonWriter& beginObject() { return open('{'); }
+    JsonWriter& endObject() { return close('}'); }
+    JsonWriter& beginArray() { return open('['); }
+    JsonWriter& endArray() { return close(']'); }
+
+    // Emits the key of the next member of the current object
+    JsonWriter& key(const std::string& name) {
+        separate();
+        writeString(name);
+        out_ << ": ";
+        afterKey_ = true;
+        return *this;
+    }
+
+    JsonWriter& value(const std::string& text) {
+        separate();
+        writeString(text);
+        return *this;
+    }
+    JsonWriter& value(const char* text) { return value(std::string(text)); }
+    JsonWriter& value(const bool flag) {
+        separate();
+        out_ << (flag ? "true" : "false");
+        return *this;
+    }
+    JsonWriter& value(const std::int64_t number) {
+        separate();
+        out_ << number;
+        return *this;
+    }
+    JsonWriter& value(const std::uint64_t number) {
+        separate();
+        out_ << number;
+        return *this;
+    }
+    JsonWriter& value(const int number) { return value(static_cast<std::int64_t>(number)); }
+    JsonWriter& value(const double number) {
+        separate();
+        if (!std::isfinite(number)) {
+            out_ << "null";
+            return *this;
+        }
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%.6g", number);
+        out_ << buffer;
+        return *this;
+    }
+
+    // Emits an already serialized JSON value as is, e.g. a report of another process
+    JsonWriter& raw(const std::string& json) {
+        separate();
+        out_ << json;
+        return *this;
+    }
+
+    // Convenience for "key": value members
+    template <typename T>
+    JsonWriter& field(const std::string& name, const T& fieldValue) {
+        key(name);
+        return value(fieldValue);
+    }
+
+private:
+    JsonWriter& open(const char bracket) {
+        separate();
+        out_ << bracket;
+        firstInScope_.push_back(true);
+        return *this;
+    }
+
+    JsonWriter& close(const char bracket) {
+        const bool empty = firstInScope_.back();
+        firstInScope_.pop_back();
+        if (!empty) {
+            newline();
+        }
+        out_ << bracket;
+        if (firstInScope_.empty()) {
+            out_ << '\n';
+        }
+        return *this;
+    }
+
+    // Writes the comma and line break that precede a new element
+    void separate() {
+        if (afterKey_) {
+            afterKey_ = false;
+            return;
+        }
+        if (firstInScope_.empty()) {
+            return;
+        }
+        if (!firstInScope_.back()) {
+            out_ << ',';
+        }
+        firstInScope_.back() = false;
+        newline();
+    }
+
+    void newline() {
+        out_ << '\n';
+        for (std::size_t i = 0; i < firstInScope_.size(); i++) {
+            out_ << "  ";
+        }
+    }
+
+    void writeString(const std::string& text) {
+        out_ << '"';
+        for (const char c : text) {
+            switch (c) {
+                case '"': out_ << "\\\""; break;
+                case '\\': out_ << "\\\\"; break;
+                case '\n': out_ << "\\n"; break;
+                case '\t': out_ << "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        char escaped[8];
+                        std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                        out_ << escaped;
+                    } else {
+                        out_ << c;
+                    }
+            }
+        }
+        out_ << '"';
+    }
+
+    std::ostream& out_;
+    std::vector<bool> firstInScope_;
+    bool afterKey_ = false;
+};
+
+/*
+    Function: writeLatency
+    ----------------------
+    Emits the summary of a latency histogram as a JSON object.
+*/
+inline void writeLatency(JsonWriter& json, const LatencyHistogram& histogram) {
+    json.beginObject()
+        .field("count", histogram.count())
+        .field("mean", histogram.mean())
+        .field("p50", histogram.percentile(0.50))
+        .field("p99", histogram.percentile(0.99))
+        .field("p999", histogram.percentile(0.999))
+        .field("max", histogram.max())
+        .endObject();
+}
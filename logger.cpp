@@ -0,0 +1,315 @@
+#include "logger.h"
+#include "spsc_ring.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+
+namespace {
+
+constexpr std::size_t RING_CAPACITY = 1024;  // Records buffered per philosopher thread
+using LogRing = SpscRing<LogRecord, RING_CAPACITY>;
+
+constexpr std::size_t MAX_LINE = 256;          // Longest formatted line; longer text is cut
+constexpr std::size_t WRITE_CHUNK = 64 * 1024;  // Drainer output buffered per fwrite
+
+struct LoggerState {
+    LogMode mode = LogMode::Sync;   // Path of the records: Async whenever a sink is installed
+    bool writeText = true;          // False when only the sinks consume the records
+    std::FILE* out = stdout;
+    bool colored = true;  // ANSI colors are only written to the console
+
+    // Pre-formatted text, built once by initLogging: "<color>Philosopher N<reset>" per
+    // philosopher, and per event the message with its activity color
+    std::vector<std::string> prefixes;
+    std::array<std::string, EVENT_COUNT> messages;
+    std::array<std::string, EVENT_COUNT> suffixes;  // Behind the number of the numeric events
+
+    std::mutex outputMutex;  // Serializes writers in sync mode
+
+    std::mutex registryMutex;  // Guards rings; taken once per thread and by the drainer
+    std::vector<std::unique_ptr<LogRing>> rings;
+    std::vector<std::unique_ptr<TraceSink>> sinks;
+    std::thread drainer;
+    std::atomic<bool> running{false};
+};
+
+LoggerState state;
+thread_local LogRing* threadRing = nullptr;
+
+std::int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+/*
+    Class: LineWriter
+    -----------------
+    Appends to a fixed character buffer, silently cutting off what does not fit.
+*/
+class LineWriter {
+public:
+    LineWriter(char* begin, const std::size_t capacity) : begin_(begin), cursor_(begin), end_(begin + capacity) {}
+
+    void append(const std::string_view text) {
+        const std::size_t length = std::min(text.size(), static_cast<std::size_t>(end_ - cursor_));
+        std::memcpy(cursor_, text.data(), length);
+        cursor_ += length;
+    }
+
+    void append(const char character) {
+        if (cursor_ != end_) {
+            *cursor_++ = character;
+        }
+    }
+
+    void append(const std::int64_t number) {
+        cursor_ = std::to_chars(cursor_, end_, number).ptr;
+    }
+
+    std::size_t size() const { return static_cast<std::size_t>(cursor_ - begin_); }
+
+private:
+    char* begin_;
+    char* cursor_;
+    char* end_;
+};
+
+/*
+    Class: TimestampCache
+    ---------------------
+    The "HH:MM:SS" text of the current second. localtime_r and strftime only run when the
+    second changes; every other record just copies the cached text.
+*/
+class TimestampCache {
+public:
+    std::string_view format(const std::int64_t timestampNs) {
+        const std::int64_t seconds = timestampNs / 1'000'000'000;
+        if (seconds != second_) {
+            const auto time = static_cast<std::time_t>(seconds);
+            std::tm local{};
+            localtime_r(&time, &local);
+            length_ = std::strftime(text_, sizeof(text_), "%T", &local);
+            second_ = seconds;
+        }
+        return {text_, length_};
+    }
+
+private:
+    std::int64_t second_ = -1;
+    char text_[16] = {};
+    std::size_t length_ = 0;
+};
+
+thread_local TimestampCache timestampCache;
+
+/*
+    Function: formatRecord
+    ----------------------
+    Writes the human-readable form of a record into line (MAX_LINE bytes) and returns its
+    length, e.g. "[12:00:01] Philosopher 0 picked up right chopstick 1.". Allocation-free.
+*/
+std::size_t formatRecord(const LogRecord& record, char* line) {
+    const auto event = static_cast<std::size_t>(record.event);
+    LineWriter writer(line, MAX_LINE);
+    writer.append('[');
+    writer.append(timestampCache.format(record.timestampNs));
+    writer.append(std::string_view("] "));
+    writer.append(std::string_view(state.prefixes[record.philosopherID]));
+    writer.append(std::string_view(state.messages[event]));
+    switch (record.event) {
+        case Event::Thought:
+        case Event::Ate:
+            writer.append(record.value);
+            writer.append(std::string_view(state.suffixes[event]));
+            break;
+        case Event::PickedLeft:
+        case Event::PickedRight:
+            writer.append(static_cast<std::int64_t>(record.chopstick));
+            writer.append(std::string_view(state.suffixes[event]));
+            break;
+        default:
+            break;
+    }
+    writer.append('\n');
+    return writer.size();
+}
+
+/*
+    Function: buildMessages
+    -----------------------
+    Pre-formats the per-philosopher prefixes and the per-event messages.
+*/
+void buildMessages(const std::vector<std::string>& philosopherColors) {
+    const std::string reset = state.colored ? RESET : "";
+    state.prefixes.clear();
+    state.prefixes.reserve(philosopherColors.size());
+    for (std::size_t id = 0; id < philosopherColors.size(); id++) {
+        const std::string color = state.colored ? philosopherColors[id] : "";
+        state.prefixes.push_back(color + "Philosopher " + std::to_string(id) + reset);
+    }
+
+    const auto set = [&](const Event event, const char* activityColor, const std::string& message,
+                         const std::string& suffix = "") {
+        const auto index = static_cast<std::size_t>(event);
+        state.messages[index] = (state.colored ? activityColor : "") + message;
+        state.suffixes[index] = suffix + reset;
+        if (suffix.empty()) {
+            state.messages[index] += reset;  // Complete without a number
+        }
+    };
+    set(Event::Thinking, THINKING, " is thinking.");
+    set(Event::Thought, THINKING, " thought for ", " ms.");
+    set(Event::Hungry, "", " is hungry and trying to pick up chopsticks.");
+    set(Event::PickedLeft, PICKING, " picked up left chopstick ", ".");
+    set(Event::PickedRight, PICKING, " picked up right chopstick ", ".");
+    set(Event::Eating, EATING, " is eating.");
+    set(Event::Ate, EATING, " ate for ", " ms.");
+    set(Event::PutDown, PUTTING, " put down chopsticks.");
+}
+
+/*
+    Function: registerThreadRing
+    ----------------------------
+    Allocates the calling thread's ring on its first event. The registry owns the ring,
+    so records left behind by a finished thread are still drained.
+*/
+LogRing* registerThreadRing() {
+    // Default-initialized on purpose: the buffer pages are only touched once records are written
+    auto ring = std::unique_ptr<LogRing>(new LogRing);
+    LogRing* raw = ring.get();
+    std::lock_guard<std::mutex> lock(state.registryMutex);
+    state.rings.push_back(std::move(ring));
+    return raw;
+}
+
+/*
+    Function: drainLoop
+    -------------------
+    Body of the background drainer thread. Collects everything currently buffered in all
+    rings, orders the batch by timestamp, passes it to the trace sinks, then formats it and
+    writes it with a single call.
+*/
+void drainLoop() {
+    std::vector<LogRecord> batch;
+    auto chunk = std::make_unique<char[]>(WRITE_CHUNK);
+    std::size_t used = 0;
+
+    while (true) {
+        const bool stopping = !state.running.load(std::memory_order_acquire);
+
+        {
+            std::lock_guard<std::mutex> lock(state.registryMutex);
+            LogRecord record{};
+            for (const auto& ring : state.rings) {
+                while (ring->tryPop(record)) {
+                    batch.push_back(record);
+                }
+            }
+        }
+
+        if (batch.empty()) {
+            if (stopping) {
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+
+        std::stable_sort(batch.begin(), batch.end(), [](const LogRecord& a, const LogRecord& b) {
+            return a.timestampNs < b.timestampNs;
+        });
+        for (const auto& sink : state.sinks) {
+            sink->write(batch);
+        }
+        if (!state.writeText) {
+            batch.clear();
+            continue;
+        }
+        for (const auto& record : batch) {
+            if (WRITE_CHUNK - used < MAX_LINE) {
+                std::fwrite(chunk.get(), 1, used, state.out);
+                used = 0;
+            }
+            used += formatRecord(record, chunk.get() + used);
+        }
+        std::fwrite(chunk.get(), 1, used, state.out);
+        std::fflush(state.out);
+
+        batch.clear();
+        used = 0;
+    }
+}
+
+}  // namespace
+
+void initLogging(LogMode mode, const std::string& path, std::vector<std::string> philosopherColors,
+                 std::vector<std::unique_ptr<TraceSink>> sinks) {
+    state.writeText = mode != LogMode::Off;
+    state.mode = sinks.empty() ? mode : LogMode::Async;
+    state.sinks = std::move(sinks);
+    state.colored = path.empty();
+    buildMessages(philosopherColors);
+
+    if (!path.empty()) {
+        state.out = std::fopen(path.c_str(), "w");
+        if (state.out == nullptr) {
+            throw std::runtime_error("cannot open log file '" + path + "'");
+        }
+    }
+
+    if (state.mode == LogMode::Async) {
+        state.running.store(true, std::memory_order_release);
+        state.drainer = std::thread(drainLoop);
+    }
+}
+
+void logEvent(const int philosopherID, const Event event, const int chopstick, const std::int64_t value) {
+    if (state.mode == LogMode::Off) {
+        return;
+    }
+    const LogRecord record{nowNs(), value, philosopherID, chopstick, event};
+
+    if (state.mode == LogMode::Sync) {
+        thread_local char line[MAX_LINE];
+        const std::size_t length = formatRecord(record, line);
+        std::lock_guard<std::mutex> lock(state.outputMutex);
+        std::fwrite(line, 1, length, state.out);
+        std::fflush(state.out);
+        return;
+    }
+
+    if (threadRing == nullptr) {
+        threadRing = registerThreadRing();
+    }
+    // Back-pressure instead of dropping: the drainer empties a full ring within a millisecond
+    while (!threadRing->tryPush(record)) {
+        std::this_thread::yield();
+    }
+}
+
+void shutdownLogging() {
+    if (state.drainer.joinable()) {
+        state.running.store(false, std::memory_order_release);
+        state.drainer.join();
+    }
+    for (const auto& sink : state.sinks) {
+        sink->close();
+    }
+    state.sinks.clear();
+    std::fflush(state.out);
+    if (state.out != stdout) {
+        std::fclose(state.out);
+        state.out = stdout;
+    }
+}
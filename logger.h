@@ -0,0 +1,112 @@
+/*
+    Logger
+    ------
+    Event logging for the philosopher threads.
+
+    Three modes are supported:
+    - Sync:  every event is formatted and written to the output stream by the calling thread
+             (the original behaviour of logWithTimestamp).
+    - Async: every event is pushed as a fixed-size binary LogRecord into a per-thread SPSC ring.
+             A single background drainer thread collects, orders, formats and writes the records
+             in batches, so the philosopher threads never touch the output stream.
+    - Off:   events are discarded (used by the benchmarks).
+
+    Independently of the text log, TraceSinks receive the binary records, e.g. to write a
+    trace file. Sinks are always fed by the drainer, so a trace implies the buffered path:
+    with sinks installed, sync text logging is performed by the drainer as well.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+// ANSI color codes for console output
+#define RESET   "\033[0m"
+
+// Activity-based colors (will combine with philosopher-specific colors)
+#define THINKING "\033[32m"      // Green for thinking
+#define EATING   "\033[31m"      // Red for eating
+#define PICKING  "\033[33m"      // Yellow for picking up chopsticks
+#define PUTTING  "\033[34m"      // Blue for putting down chopsticks
+
+enum class LogMode : std::uint8_t {
+    Sync,
+    Async,
+    Off
+};
+
+// Every state transition a philosopher can report
+enum class Event : std::uint8_t {
+    Thinking,       // Started thinking
+    Thought,        // Finished thinking (value = duration in ms)
+    Hungry,         // Trying to pick up chopsticks
+    PickedLeft,     // Picked up the left chopstick
+    PickedRight,    // Picked up the right chopstick
+    Eating,         // Started eating
+    Ate,            // Finished eating (value = duration in ms)
+    PutDown         // Put down the chopsticks held (both after a meal, one after a backoff)
+};
+
+inline constexpr std::size_t EVENT_COUNT = 8;
+
+// Fixed-size binary record pushed by the philosopher threads in async mode
+struct LogRecord {
+    std::int64_t timestampNs;   // Wall-clock time since epoch, in nanoseconds
+    std::int64_t value;         // Event-specific payload (e.g. a duration)
+    std::int32_t philosopherID;
+    std::int32_t chopstick;     // Chopstick index, or -1 if not applicable
+    Event event;
+};
+
+/*
+    Class: TraceSink
+    ----------------
+    Consumer of the buffered event stream. The drainer thread hands every batch of records,
+    sorted by timestamp, to each sink; the records of one philosopher arrive in order across
+    batches. close() is called by shutdownLogging() after the last batch.
+*/
+class TraceSink {
+public:
+    virtual ~TraceSink() = default;
+
+    virtual void write(std::span<const LogRecord> records) = 0;
+    virtual void close() {}
+};
+
+/*
+    Function: initLogging
+    ---------------------
+    Configures the logging backend. Must be called before any philosopher thread starts.
+
+    Parameters:
+    - mode: synchronous or asynchronous logging.
+    - path: output file; an empty path writes to stdout.
+    - philosopherColors: ANSI color of every philosopher, indexed by ID.
+    - sinks: trace sinks fed with every record, in any mode.
+
+    Every per-philosopher prefix and per-event message is formatted here, once, so that
+    logging an event later performs no heap allocation.
+*/
+void initLogging(LogMode mode, const std::string& path, std::vector<std::string> philosopherColors,
+                 std::vector<std::unique_ptr<TraceSink>> sinks = {});
+
+/*
+    Function: logEvent
+    ------------------
+    Records a philosopher state transition. In async mode this only copies a LogRecord into
+    the calling thread's ring buffer.
+*/
+void logEvent(int philosopherID, Event event, int chopstick = -1, std::int64_t value = 0);
+
+/*
+    Function: shutdownLogging
+    -------------------------
+    Drains every pending record, stops the drainer thread, closes the trace sinks and the
+    output.
+*/
+void shutdownLogging();
@@ -20,188 +20,151 @@
     Solution Strategy:
     ------------------
     The solution is influenced by the book "Operating System Concepts" by Silberschatz, Galvin, and Gagne section 7.1.
-    The solution uses semaphores to represent chopsticks and follows an asymmetric approach:
+    The default solution uses semaphores to represent chopsticks and follows an asymmetric approach:
     - Odd-numbered philosophers pick up their left chopstick first, while even-numbered philosophers
       pick up their right chopstick first.
     This prevents deadlock by ensuring that not all philosophers are waiting for chopsticks in a circular pattern.
     The solution guarantees that no two adjacent philosophers eat simultaneously and avoids deadlock.
+    Resource ordering, a waiter and Chandy-Misra forks can be selected instead (see strategy.h).
 
     Author: Savan Patel
 */
 
-#include <iostream>
-#include <thread>
-#include <mutex>
-#include <semaphore.h>
 #include <chrono>
-#include <iomanip>
-#include <ctime>
-
-constexpr int NUM_PHILOSOPHERS = 5;  // Total number of philosophers
-
-// Binary semaphores to represent the chopsticks, initialized to 1 (available)
-std::binary_semaphore chopsticks[NUM_PHILOSOPHERS] = {
-    std::binary_semaphore(1),
-    std::binary_semaphore(1),
-    std::binary_semaphore(1),
-    std::binary_semaphore(1),
-    std::binary_semaphore(1)
-};
-
-// ANSI color codes for console output
-#define RESET   "\033[0m"
-
-// Activity-based colors (will combine with philosopher-specific colors)
-#define THINKING "\033[32m"      // Green for thinking
-#define EATING   "\033[31m"      // Red for eating
-#define PICKING  "\033[33m"      // Yellow for picking up chopsticks
-#define PUTTING  "\033[34m"      // Blue for putting down chopsticks
-
-// ANSI color codes for philosopher-specific colors
-#define PHIL0   "\033[35m"      // Philosopher 0 - Magenta
-#define PHIL1   "\033[36m"      // Philosopher 1 - Cyan
-#define PHIL2   "\033[93m"      // Philosopher 2 - Bright Yellow
-#define PHIL3   "\033[95m"      // Philosopher 3 - Bright Magenta
-#define PHIL4   "\033[96m"      // Philosopher 4 - Bright Cyan
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+#include "chrome_trace.h"
+#include "config.h"
+#include "deadlock_detector.h"
+#include "logger.h"
+#include "metrics_server.h"
+#include "philosopher.h"
+#include "stats_reporter.h"
+#include "sweep.h"
+#include "trace_file.h"
+#include "watchdog.h"
 
 /*
-    Function: logWithTimestamp
+    Function: philosopherColor
     --------------------------
-    Logs a message to the console with the current timestamp.
-*/
-void logWithTimestamp(const std::string& philosopherColor, const std::string& activityColor, const std::string& philosopherID, const std::string& message) {
-    auto now = std::chrono::system_clock::now();
-    std::time_t now_time = std::chrono::system_clock::to_time_t(now);
-    std::cout << "[" << std::put_time(std::localtime(&now_time), "%T") << "] "
-              << philosopherColor << philosopherID << RESET
-              << activityColor << message << RESET << std::endl;
-}
-
-
-/*
-    Function: think
-    ----------------
-    Simulates the thinking process of a philosopher.
-
-    Parameters:
-    - philosopherID: the ID of the philosopher.
-
-    This function simulates the philosopher thinking for a period of time.
-*/
-void think(const int philosopherID, const std::string& philosopherColor) {
-    auto start_time = std::chrono::high_resolution_clock::now();
-
-    // Log the philosopher's name in their specific color and the activity in the activity color
-    logWithTimestamp(philosopherColor, THINKING, "Philosopher " + std::to_string(philosopherID), " is thinking.");
-    std::this_thread::sleep_for(std::chrono::milliseconds(3000));  // Simulate thinking time
-
-    auto end_time = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
-
-    // Log the completion of the thinking process with the duration
-    logWithTimestamp(philosopherColor, THINKING, "Philosopher " + std::to_string(philosopherID), " thought for " + std::to_string(duration) + " ms.");
-}
-
-/*
-    Function: eat
-    --------------
-    Simulates the eating process of a philosopher.
-
-    Parameters:
-    - philosopherID: the ID of the philosopher.
-
-    This function simulates the philosopher eating for a period of time.
+    Returns the ANSI color of a philosopher. The first five keep their classic colors;
+    the rest are spread over the 256-color palette, skipping the dark and grayscale ranges.
 */
-void eat(const int philosopherID, const std::string& philosopherColor) {
-    auto start_time = std::chrono::high_resolution_clock::now();
-
-    // Log the philosopher's name in their specific color and the activity in the activity color (eating)
-    logWithTimestamp(philosopherColor, EATING, "Philosopher " + std::to_string(philosopherID), " is eating.");
-    std::this_thread::sleep_for(std::chrono::milliseconds(3000));  // Simulate eating time
-
-    auto end_time = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
-
-    // Log the completion of the eating process with the duration
-    logWithTimestamp(philosopherColor, EATING, "Philosopher " + std::to_string(philosopherID), " ate for " + std::to_string(duration) + " ms.");
-}
-
-
-/*
-    Function: philosopher
-    ---------------------
-    Controls the actions of each philosopher: alternating between thinking and eating.
-
-    Parameters:
-    - philosopherID: the ID of the philosopher.
-
-    Each philosopher tries to pick up their chopsticks (represented as semaphores).
-    Odd philosophers pick up their left chopstick first, and even philosophers pick
-    up their right chopstick first to avoid deadlock.
-*/
-[[noreturn]] void philosopher(const int philosopherID, const std::string& philosopherColor) {
-    const int leftChopstick = philosopherID;  // Left chopstick for the philosopher
-    const int rightChopstick = (philosopherID + 1) % NUM_PHILOSOPHERS;  // Right chopstick for the philosopher
-
-    // Continuous loop for alternating between thinking and eating
-    while (true) {
-        think(philosopherID, philosopherColor);  // Simulate thinking process
-
-        // Philosopher is hungry and trying to pick up chopsticks
-        logWithTimestamp(philosopherColor, "", "Philosopher " + std::to_string(philosopherID), " is hungry and trying to pick up chopsticks.");
-
-        // Asymmetric chopstick picking to prevent deadlock
-        if (philosopherID % 2 == 0) {
-            // Even-numbered philosophers pick up the right chopstick first
-            chopsticks[rightChopstick].acquire();
-            logWithTimestamp(philosopherColor, PICKING, "Philosopher " + std::to_string(philosopherID), " picked up right chopstick " + std::to_string(rightChopstick) + ".");
-
-            chopsticks[leftChopstick].acquire();
-            logWithTimestamp(philosopherColor, PICKING, "Philosopher " + std::to_string(philosopherID), " picked up left chopstick " + std::to_string(leftChopstick) + ".");
-        } else {
-            // Odd-numbered philosophers pick up the left chopstick first
-            chopsticks[leftChopstick].acquire();
-            logWithTimestamp(philosopherColor, PICKING, "Philosopher " + std::to_string(philosopherID), " picked up left chopstick " + std::to_string(leftChopstick) + ".");
-
-            chopsticks[rightChopstick].acquire();
-            logWithTimestamp(philosopherColor, PICKING, "Philosopher " + std::to_string(philosopherID), " picked up right chopstick " + std::to_string(rightChopstick) + ".");
-        }
-
-        eat(philosopherID, philosopherColor);  // Simulate eating process
-
-        // Philosopher puts down both chopsticks after eating
-        chopsticks[leftChopstick].release();
-        chopsticks[rightChopstick].release();
-
-        logWithTimestamp(philosopherColor, PUTTING, "Philosopher " + std::to_string(philosopherID), " put down chopsticks.");
+std::string philosopherColor(const int philosopherID) {
+    static const char* const classicColors[] = {
+        "\033[35m",  // Philosopher 0 - Magenta
+        "\033[36m",  // Philosopher 1 - Cyan
+        "\033[93m",  // Philosopher 2 - Bright Yellow
+        "\033[95m",  // Philosopher 3 - Bright Magenta
+        "\033[96m"   // Philosopher 4 - Bright Cyan
+    };
+    if (philosopherID < 5) {
+        return classicColors[philosopherID];
     }
+    // 6x6x6 color cube occupies codes 16..231; stride by a value coprime to 180 over 52..231
+    const int code = 52 + (philosopherID * 37) % 180;
+    return "\033[38;5;" + std::to_string(code) + "m";
 }
 
-
 /*
     Function: main
     --------------
     Entry point of the program.
 
-    This function creates philosopher threads and simulates the dining philosophers problem.
-    Each philosopher operates concurrently.
+    This function parses the command line, configures logging, creates philosopher threads
+    and simulates the dining philosophers problem. Each philosopher operates concurrently.
+    The run ends at the configured duration or meal limit, or on SIGINT/SIGTERM, after which
+    the final counters are printed to stderr.
 */
-int main() {
-    // Array of philosopher threads
-    std::thread philosophers[NUM_PHILOSOPHERS];
+int main(int argc, char* argv[]) {
+    Config config;
+    try {
+        config = parseArgs(argc, argv);
+    } catch (const std::invalid_argument& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        printUsage(argv[0]);
+        return 1;
+    }
+    if (config.help) {
+        printUsage(argv[0]);
+        return 0;
+    }
+
+    if (config.mode == Mode::Sweep) {
+        return runSweep(config, argc, argv);  // Every run logs for itself
+    }
+    if (config.mode == Mode::LayoutBench) {
+        return runLayoutBenchmark(config);
+    }
+    if (config.mode == Mode::Des) {
+        return runDiscreteEventBenchmark(config);  // Virtual time: nothing to log
+    }
+    if (config.mode == Mode::GraphBench) {
+        return runGraphBenchmark(config);
+    }
 
     // Philosopher-specific colors
-    const std::string philosopherColors[NUM_PHILOSOPHERS] = {PHIL0, PHIL1, PHIL2, PHIL3, PHIL4};
+    std::vector<std::string> philosopherColors;
+    philosopherColors.reserve(config.numPhilosophers);
+    for (int i = 0; i < config.numPhilosophers; i++) {
+        philosopherColors.push_back(philosopherColor(i));
+    }
 
-    // Create and launch philosopher threads
-    for (int i = 0; i < NUM_PHILOSOPHERS; i++) {
-        philosophers[i] = std::thread(philosopher, i, philosopherColors[i]);  // Each thread simulates a philosopher
+    try {
+        std::vector<std::unique_ptr<TraceSink>> sinks;
+        if (!config.traceFile.empty()) {
+            sinks.push_back(std::make_unique<TraceFileWriter>(config.traceFile, config.numPhilosophers,
+                                                              config.numPhilosophers));
+        }
+        if (!config.chromeTraceFile.empty()) {
+            sinks.push_back(std::make_unique<ChromeTraceSink>(config.chromeTraceFile, config.numPhilosophers,
+                                                              config.numPhilosophers));
+        }
+        initLogging(config.logMode, config.logFile, std::move(philosopherColors), std::move(sinks));
+    } catch (const std::runtime_error& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
     }
 
-    // Join philosopher threads (this will not happen in this infinite loop simulation)
-    for (auto & philosopher : philosophers) {
-        philosopher.join();
+    if (config.mode == Mode::Bench) {
+        const int status = runBenchmark(config);
+        shutdownLogging();
+        return status;
     }
 
-    return 0;  // Program never reaches here because of the infinite loop in philosopher()
+    DiningTable table(config);
+    std::optional<MetricsServer> metrics;
+    if (config.metrics.enabled()) {
+        try {
+            metrics.emplace(table, config.metrics);
+        } catch (const std::runtime_error& e) {
+            shutdownLogging();
+            std::cerr << "Error: " << e.what() << std::endl;
+            return 1;
+        }
+        std::cerr << "Serving metrics on http://" << config.metrics.describe() << "/metrics" << std::endl;
+    }
+    {
+        StatsReporter reporter(table, config.statsIntervalMs);
+        Watchdog watchdog(table, std::chrono::milliseconds(config.waitSloMs), config.fairnessThreshold);
+        DeadlockDetector detector(table, std::chrono::milliseconds(config.deadlockCheckMs));
+
+        // Runs until the duration or meal limit is reached, or until Ctrl-C / SIGTERM
+        runTable(table, config);
+        watchdog.stop();
+        detector.stop();
+
+        shutdownLogging();  // Flush the log before the final counters
+        reporter.printSnapshot(stderr);
+        watchdog.printSummary(stderr);
+        detector.printSummary(stderr);
+    }
+    return 0;
 }
@@ -0,0 +1,222 @@
+/*
+    Metrics
+    -------
+    Per-philosopher measurements collected by the philosopher loop.
+*/
+
+#pragma once
+
+#include "cache_line.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+/*
+    Class: LatencyHistogram
+    -----------------------
+    Log-linear histogram of nanosecond latencies. Values below 16 ns get exact buckets; every
+    power-of-two range above is split into 16 sub-buckets, bounding the relative error of a
+    reported percentile to about 3%. Values above ~68 s land in the last bucket.
+*/
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BUCKET_BITS = 4;
+    static constexpr int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static constexpr int MAX_EXPONENT = 36;  // 2^36 ns ~ 68.7 s
+    static constexpr int NUM_BUCKETS = (MAX_EXPONENT - SUB_BUCKET_BITS + 2) * SUB_BUCKETS;
+
+    static int bucketOf(const std::uint64_t valueNs) {
+        if (valueNs < SUB_BUCKETS) {
+            return static_cast<int>(valueNs);
+        }
+        const int exponent = std::bit_width(valueNs) - 1;
+        const int shift = exponent - SUB_BUCKET_BITS;
+        const int index = (shift + 1) * SUB_BUCKETS + static_cast<int>((valueNs >> shift) - SUB_BUCKETS);
+        return std::min(index, NUM_BUCKETS - 1);
+    }
+
+    // Smallest value that falls into the bucket
+    static std::uint64_t bucketLowerBound(const int bucket) {
+        if (bucket < SUB_BUCKETS) {
+            return static_cast<std::uint64_t>(bucket);
+        }
+        const int shift = bucket / SUB_BUCKETS - 1;
+        return static_cast<std::uint64_t>(SUB_BUCKETS + bucket % SUB_BUCKETS) << shift;
+    }
+
+    void record(const std::uint64_t valueNs) {
+        counts_[bucketOf(valueNs)]++;
+        count_++;
+        sum_ += valueNs;
+        max_ = std::max(max_, valueNs);
+    }
+
+    void merge(const LatencyHistogram& other) {
+        for (int i = 0; i < NUM_BUCKETS; i++) {
+            counts_[i] += other.counts_[i];
+        }
+        count_ += other.count_;
+        sum_ += other.sum_;
+        max_ = std::max(max_, other.max_);
+    }
+
+    // Value at the given quantile (0..1), reported as the midpoint of its bucket
+    std::uint64_t percentile(const double quantile) const {
+        if (count_ == 0) {
+            return 0;
+        }
+        const auto rank = static_cast<std::uint64_t>(quantile * static_cast<double>(count_ - 1)) + 1;
+        std::uint64_t seen = 0;
+        for (int i = 0; i < NUM_BUCKETS; i++) {
+            seen += counts_[i];
+            if (seen >= rank) {
+                const std::uint64_t low = bucketLowerBound(i);
+                const std::uint64_t high = i + 1 < NUM_BUCKETS ? bucketLowerBound(i + 1) : max_ + 1;
+                return std::min(low + (high - low - 1) / 2, max_);
+            }
+        }
+        return max_;
+    }
+
+    std::uint64_t count() const { return count_; }
+    std::uint64_t max() const { return max_; }
+    double mean() const { return count_ == 0 ? 0.0 : static_cast<double>(sum_) / static_cast<double>(count_); }
+
+private:
+    std::array<std::uint64_t, NUM_BUCKETS> counts_{};
+    std::uint64_t count_ = 0;
+    std::uint64_t sum_ = 0;
+    std::uint64_t max_ = 0;
+};
+
+/*
+    Function: bump
+    --------------
+    Adds to a counter that only the calling thread writes. A relaxed load and store instead of
+    a read-modify-write keeps the hot path free of locked instructions, while concurrent
+    readers still see a consistent, monotonically growing value.
+*/
+inline void bump(std::atomic<std::uint64_t>& counter, const std::uint64_t delta = 1) {
+    counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+}
+
+// Raises a counter that only the calling thread writes to at least value
+inline void raiseMax(std::atomic<std::uint64_t>& counter, const std::uint64_t value) {
+    if (value > counter.load(std::memory_order_relaxed)) {
+        counter.store(value, std::memory_order_relaxed);
+    }
+}
+
+/*
+    Function: jainFairness
+    ----------------------
+    Jain's fairness index (sum x)^2 / (n * sum x^2) of a set of shares, such as meals per
+    philosopher: 1 when all shares are equal, down to 1/n when one philosopher gets everything.
+*/
+template <typename Range>
+double jainFairness(const Range& shares) {
+    double sum = 0.0;
+    double sumOfSquares = 0.0;
+    std::size_t n = 0;
+    for (const auto share : shares) {
+        const auto value = static_cast<double>(share);
+        sum += value;
+        sumOfSquares += value * value;
+        n++;
+    }
+    if (sumOfSquares == 0.0) {
+        return 1.0;
+    }
+    return sum * sum / (static_cast<double>(n) * sumOfSquares);
+}
+
+// Upper bounds of the live hungry-wait buckets, 1 us to 10 s by decades; one more bucket
+// takes the longer waits
+inline constexpr std::array<std::uint64_t, 8> LIVE_WAIT_BOUNDS_NS = {
+    1'000, 10'000, 100'000, 1'000'000, 10'000'000, 100'000'000, 1'000'000'000, 10'000'000'000};
+constexpr int NUM_LIVE_WAIT_BUCKETS = static_cast<int>(LIVE_WAIT_BOUNDS_NS.size()) + 1;
+
+inline int liveWaitBucketOf(const std::uint64_t waitNs) {
+    int bucket = 0;
+    while (bucket < NUM_LIVE_WAIT_BUCKETS - 1 && waitNs > LIVE_WAIT_BOUNDS_NS[bucket]) {
+        bucket++;
+    }
+    return bucket;
+}
+
+/*
+    Struct: WaitState
+    -----------------
+    What a philosopher blocked on a chopstick holds and waits for, packed into one word so
+    that the philosopher publishes it with a single relaxed store: chopstick + 1 of the held
+    chopstick in the high half and of the awaited one in the low half, 0 if not blocked.
+*/
+struct WaitState {
+    int held = -1;     // Chopstick held while waiting, -1 if none
+    int waiting = -1;  // Chopstick waited for, -1 if not blocked
+
+    std::uint64_t pack() const {
+        return static_cast<std::uint64_t>(static_cast<std::uint32_t>(held + 1)) << 32 |
+               static_cast<std::uint32_t>(waiting + 1);
+    }
+
+    static WaitState unpack(const std::uint64_t word) {
+        return WaitState{static_cast<int>(word >> 32) - 1, static_cast<int>(word & 0xffffffffU) - 1};
+    }
+};
+
+/*
+    Struct: PhilosopherStats
+    ------------------------
+    Per-philosopher measurements. Every field is written only by the owning philosopher thread.
+    The atomic counters may be read at any time by snapshot readers, the watchdog and the
+    metrics endpoint: the first cache line holds the ones the loop updates every meal; the
+    live wait buckets and the right-chopstick tries follow. The histogram and the scratch
+    fields are read once the run has finished.
+*/
+struct alignas(CACHE_LINE_SIZE) PhilosopherStats {
+    std::atomic<std::uint64_t> meals{0};
+    std::atomic<std::uint64_t> hungryNs{0};           // Cumulative time from "hungry" to holding both
+    std::atomic<std::uint64_t> halfHeldNs{0};         // Cumulative time holding the first but not the second
+    std::atomic<std::uint64_t> failedTryAcquires{0};  // Chopstick attempts that found it taken
+    std::atomic<std::uint64_t> maxWaitNs{0};          // Longest single hungry wait
+    std::atomic<std::int64_t> hungrySinceNs{0};       // Steady-clock start of the current wait, 0 if not hungry
+    std::atomic<std::uint64_t> waitState{0};          // Blocked wait for the deadlock detector (see WaitState)
+    std::atomic<std::uint64_t> backoffs{0};           // Chopsticks put back by the backoff strategy
+
+    // Coarse live copy of the hungry-wait histogram, indexed by liveWaitBucketOf()
+    std::array<std::atomic<std::uint64_t>, NUM_LIVE_WAIT_BUCKETS> liveWaitBuckets{};
+    // The failed tries that were on the right chopstick; the rest were on the left one
+    std::atomic<std::uint64_t> failedRightTryAcquires{0};
+
+    // Scratch state of the current acquisition
+    int chopsticksHeld = 0;
+    std::chrono::steady_clock::time_point firstPickedUp{};
+    bool waitPublished = false;  // waitState is set
+
+    LatencyHistogram hungryWait;  // From "hungry" until both chopsticks are held
+};
+
+// Totals over a set of philosophers, taken from the atomic counters
+struct StatsSnapshot {
+    std::uint64_t meals = 0;
+    std::uint64_t hungryNs = 0;
+    std::uint64_t halfHeldNs = 0;
+    std::uint64_t failedTryAcquires = 0;
+    std::uint64_t maxWaitNs = 0;
+    std::uint64_t backoffs = 0;
+
+    void add(const PhilosopherStats& stats) {
+        meals += stats.meals.load(std::memory_order_relaxed);
+        hungryNs += stats.hungryNs.load(std::memory_order_relaxed);
+        halfHeldNs += stats.halfHeldNs.load(std::memory_order_relaxed);
+        failedTryAcquires += stats.failedTryAcquires.load(std::memory_order_relaxed);
+        maxWaitNs = std::max(maxWaitNs, stats.maxWaitNs.load(std::memory_order_relaxed));
+        backoffs += stats.backoffs.load(std::memory_order_relaxed);
+    }
+};
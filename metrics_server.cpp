@@ -0,0 +1,199 @@
+#include "metrics_server.h"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr int POLL_MS = 100;             // How quickly the server notices the stop
+constexpr std::size_t MAX_REQUEST = 8192;  // Longer request heads are cut off
+
+void appendHeader(std::string& out, const char* name, const char* type, const char* help) {
+    out += "# HELP ";
+    out += name;
+    out += ' ';
+    out += help;
+    out += "\n# TYPE ";
+    out += name;
+    out += ' ';
+    out += type;
+    out += '\n';
+}
+
+void appendSample(std::string& out, const char* name, const char* label, const int id, const std::uint64_t value) {
+    char line[128];
+    const int length = std::snprintf(line, sizeof(line), "%s{%s=\"%d\"} %llu\n", name, label, id,
+                                     static_cast<unsigned long long>(value));
+    out.append(line, static_cast<std::size_t>(length));
+}
+
+// Sends the whole buffer unless the client goes away
+void sendAll(const int client, const std::string& data) {
+    std::size_t sent = 0;
+    while (sent < data.size()) {
+        const ssize_t written = ::send(client, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (written <= 0) {
+            if (written < 0 && errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        sent += static_cast<std::size_t>(written);
+    }
+}
+
+std::string response(const char* status, const char* contentType, const std::string& body, const bool withBody) {
+    std::string out = "HTTP/1.1 ";
+    out += status;
+    out += "\r\nContent-Type: ";
+    out += contentType;
+    out += "\r\nContent-Length: " + std::to_string(body.size()) + "\r\nConnection: close\r\n\r\n";
+    if (withBody) {
+        out += body;
+    }
+    return out;
+}
+
+}  // namespace
+
+MetricsServer::MetricsServer(const DiningTable& table, const MetricsAddress& address) : table_(table) {
+    listenFd_ = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listenFd_ < 0) {
+        throw std::runtime_error(std::string("cannot create the metrics socket: ") + std::strerror(errno));
+    }
+    const int reuse = 1;
+    ::setsockopt(listenFd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in bound{};
+    bound.sin_family = AF_INET;
+    bound.sin_port = htons(static_cast<std::uint16_t>(address.port));
+    ::inet_pton(AF_INET, address.host.c_str(), &bound.sin_addr);
+    if (::bind(listenFd_, reinterpret_cast<const sockaddr*>(&bound), sizeof(bound)) != 0 ||
+        ::listen(listenFd_, 16) != 0) {
+        const int error = errno;
+        ::close(listenFd_);
+        throw std::runtime_error("cannot listen on " + address.describe() + ": " + std::strerror(error));
+    }
+    thread_ = std::jthread([this](const std::stop_token stop) { run(stop); });
+}
+
+MetricsServer::~MetricsServer() {
+    thread_.request_stop();
+    thread_.join();
+    ::close(listenFd_);
+}
+
+std::string MetricsServer::render() const {
+    const int n = table_.numPhilosophers;
+    std::string out;
+    out.reserve(static_cast<std::size_t>(n) * 96 + 1024);
+
+    appendHeader(out, "dining_meals_total", "counter", "Meals eaten by the philosopher.");
+    for (int i = 0; i < n; i++) {
+        appendSample(out, "dining_meals_total", "philosopher", i, table_.stats[i].meals.load(std::memory_order_relaxed));
+    }
+
+    std::array<std::uint64_t, NUM_LIVE_WAIT_BUCKETS> buckets{};
+    std::uint64_t hungryNs = 0;
+    for (int i = 0; i < n; i++) {
+        const PhilosopherStats& stats = table_.stats[i];
+        for (int b = 0; b < NUM_LIVE_WAIT_BUCKETS; b++) {
+            buckets[b] += stats.liveWaitBuckets[b].load(std::memory_order_relaxed);
+        }
+        hungryNs += stats.hungryNs.load(std::memory_order_relaxed);
+    }
+    appendHeader(out, "dining_hungry_wait_seconds", "histogram",
+                 "Time from becoming hungry until both chopsticks are held.");
+    std::uint64_t cumulative = 0;
+    char line[128];
+    for (int b = 0; b < NUM_LIVE_WAIT_BUCKETS; b++) {
+        cumulative += buckets[b];
+        int length;
+        if (b < NUM_LIVE_WAIT_BUCKETS - 1) {
+            length = std::snprintf(line, sizeof(line), "dining_hungry_wait_seconds_bucket{le=\"%g\"} %llu\n",
+                                   static_cast<double>(LIVE_WAIT_BOUNDS_NS[b]) / 1e9,
+                                   static_cast<unsigned long long>(cumulative));
+        } else {
+            length = std::snprintf(line, sizeof(line), "dining_hungry_wait_seconds_bucket{le=\"+Inf\"} %llu\n",
+                                   static_cast<unsigned long long>(cumulative));
+        }
+        out.append(line, static_cast<std::size_t>(length));
+    }
+    const int length = std::snprintf(line, sizeof(line), "dining_hungry_wait_seconds_sum %.9f\n"
+                                                         "dining_hungry_wait_seconds_count %llu\n",
+                                     static_cast<double>(hungryNs) / 1e9, static_cast<unsigned long long>(cumulative));
+    out.append(line, static_cast<std::size_t>(length));
+
+    // Chopstick i is the left one of seat i and the right one of seat i - 1
+    appendHeader(out, "dining_chopstick_contended_total", "counter", "Pickups that found the chopstick taken.");
+    for (int i = 0; i < n; i++) {
+        const PhilosopherStats& owner = table_.stats[i];
+        const PhilosopherStats& left = table_.stats[(i + n - 1) % n];
+        const std::uint64_t right = owner.failedRightTryAcquires.load(std::memory_order_relaxed);
+        const std::uint64_t all = owner.failedTryAcquires.load(std::memory_order_relaxed);
+        appendSample(out, "dining_chopstick_contended_total", "chopstick", i,
+                     all - std::min(all, right) + left.failedRightTryAcquires.load(std::memory_order_relaxed));
+    }
+    return out;
+}
+
+void MetricsServer::run(const std::stop_token stop) {
+    while (!stop.stop_requested()) {
+        pollfd listening{listenFd_, POLLIN, 0};
+        if (::poll(&listening, 1, POLL_MS) <= 0) {
+            continue;
+        }
+        const int client = ::accept4(listenFd_, nullptr, nullptr, SOCK_CLOEXEC);
+        if (client < 0) {
+            continue;
+        }
+        serve(client);
+        ::close(client);
+    }
+}
+
+void MetricsServer::serve(const int client) const {
+    // A client that sends nothing must not hold up the next scrape for long
+    const timeval timeout{1, 0};
+    ::setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    std::string request;
+    char buffer[1024];
+    while (request.size() < MAX_REQUEST && request.find("\r\n\r\n") == std::string::npos) {
+        const ssize_t received = ::recv(client, buffer, sizeof(buffer), 0);
+        if (received <= 0) {
+            break;
+        }
+        request.append(buffer, static_cast<std::size_t>(received));
+    }
+
+    // Request line: METHOD SP TARGET SP VERSION
+    const std::size_t methodEnd = request.find(' ');
+    const std::size_t targetEnd = methodEnd == std::string::npos ? std::string::npos : request.find(' ', methodEnd + 1);
+    if (targetEnd == std::string::npos) {
+        sendAll(client, response("400 Bad Request", "text/plain", "bad request\n", true));
+        return;
+    }
+    const std::string method = request.substr(0, methodEnd);
+    std::string target = request.substr(methodEnd + 1, targetEnd - methodEnd - 1);
+    target.resize(std::min(target.size(), target.find('?')));
+
+    if (method != "GET" && method != "HEAD") {
+        sendAll(client, response("405 Method Not Allowed", "text/plain", "only GET and HEAD\n", true));
+    } else if (target != "/metrics") {
+        sendAll(client, response("404 Not Found", "text/plain", "metrics are at /metrics\n", method == "GET"));
+    } else {
+        sendAll(client, response("200 OK", "text/plain; version=0.0.4; charset=utf-8", render(), method == "GET"));
+    }
+}
@@ -0,0 +1,48 @@
+/*
+    MetricsServer
+    -------------
+    Minimal HTTP endpoint serving the table's live counters in the Prometheus text
+    exposition format, for long-running soak tests:
+    - dining_meals_total{philosopher}: meals eaten by every philosopher,
+    - dining_hungry_wait_seconds: histogram of the waits from hungry to holding both
+      chopsticks, over the whole table, with decade buckets from 1 us to 10 s,
+    - dining_chopstick_contended_total{chopstick}: pickups that found the chopstick taken.
+
+    Like the StatsReporter it only reads the relaxed atomics of the per-philosopher counter
+    blocks, so a scrape never locks or slows down a philosopher. A chopstick's contention is
+    the sum of its two neighbours' failed tries on their sides of it, which the strategies
+    count separately (see noteFailedTryAcquire()).
+
+    One thread accepts connections and answers them one at a time: GET or HEAD /metrics,
+    then the connection is closed. Anything else gets a 404 or 405.
+*/
+
+#pragma once
+
+#include "config.h"
+#include "philosopher.h"
+
+#include <stop_token>
+#include <string>
+#include <thread>
+
+class MetricsServer {
+public:
+    // Listens on the address right away; throws std::runtime_error if it cannot
+    MetricsServer(const DiningTable& table, const MetricsAddress& address);
+    ~MetricsServer();
+
+    MetricsServer(const MetricsServer&) = delete;
+    MetricsServer& operator=(const MetricsServer&) = delete;
+
+    // Current counters in the text exposition format
+    std::string render() const;
+
+private:
+    void run(std::stop_token stop);
+    void serve(int client) const;
+
+    const DiningTable& table_;
+    int listenFd_ = -1;
+    std::jthread thread_;
+};
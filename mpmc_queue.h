@@ -0,0 +1,90 @@
+/*
+    MpmcQueue
+    ---------
+    Bounded multi-producer / multi-consumer queue (Dmitry Vyukov's array queue).
+
+    Every cell carries a sequence number that tells producers and consumers whose turn the
+    cell is: a producer claims the cell at position p once its sequence equals p, a consumer
+    once it equals p + 1. A claim is one CAS on the shared enqueue or dequeue position, and
+    the cell is handed over by a release store of its next sequence, so neither side ever
+    waits for a preempted thread holding a lock. tryPush() fails only when the queue is full,
+    tryPop() only when it is empty. Values come out in the order their pushes claimed
+    positions, so the pushes of one thread stay in order.
+*/
+
+#pragma once
+
+#include "cache_line.h"
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+
+template <typename T>
+class MpmcQueue {
+public:
+    // Room for at least minCapacity values, rounded up to a power of two
+    explicit MpmcQueue(const std::size_t minCapacity)
+        : capacity_(std::bit_ceil(minCapacity < 2 ? std::size_t{2} : minCapacity)),
+          cells_(std::make_unique<Cell[]>(capacity_)) {
+        for (std::size_t i = 0; i < capacity_; i++) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    bool tryPush(const T& value) {
+        std::size_t position = enqueuePosition_.load(std::memory_order_relaxed);
+        while (true) {
+            Cell& cell = cells_[position & (capacity_ - 1)];
+            const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto lag = static_cast<std::ptrdiff_t>(sequence - position);
+            if (lag == 0) {
+                if (enqueuePosition_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    cell.value = value;
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (lag < 0) {
+                return false;  // Full: the cell still holds the value of the previous lap
+            } else {
+                position = enqueuePosition_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool tryPop(T& value) {
+        std::size_t position = dequeuePosition_.load(std::memory_order_relaxed);
+        while (true) {
+            Cell& cell = cells_[position & (capacity_ - 1)];
+            const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto lag = static_cast<std::ptrdiff_t>(sequence - (position + 1));
+            if (lag == 0) {
+                if (dequeuePosition_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    value = cell.value;
+                    cell.sequence.store(position + capacity_, std::memory_order_release);
+                    return true;
+                }
+            } else if (lag < 0) {
+                return false;  // Empty: the cell's value has not been written yet
+            } else {
+                position = dequeuePosition_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    std::size_t capacity() const { return capacity_; }
+
+private:
+    struct Cell {
+        std::atomic<std::size_t> sequence{0};
+        T value{};
+    };
+
+    const std::size_t capacity_;
+    const std::unique_ptr<Cell[]> cells_;
+
+    // Producer and consumer positions on their own cache lines
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> enqueuePosition_{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> dequeuePosition_{0};
+};
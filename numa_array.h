@@ -0,0 +1,92 @@
+/*
+    NumaArray
+    ---------
+    Fixed-size array whose pages are placed on chosen NUMA nodes.
+
+    The memory is mapped anonymously and, before any page is touched, each run of pages is
+    bound with mbind(MPOL_PREFERRED) to the node that nodeOf returns for the first element
+    on it; the elements are constructed only afterwards, so the first touch already lands on
+    that node. Placement is best effort: without a nodeOf, with nodeOf returning -1, or when
+    the kernel refuses the policy, the pages fall back to the default first-touch placement.
+    mbind is called directly, so no libnuma is needed.
+
+    Placement is per page, so elements sharing a page share a node; chopsticks are padded to
+    a cache line, 64 to a page.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+template <typename T>
+class NumaArray {
+public:
+    explicit NumaArray(const int size, const std::function<int(int)>& nodeOf = {}) : size_(size) {
+        const auto pageSize = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+        bytes_ = std::max<std::size_t>((sizeof(T) * static_cast<std::size_t>(size) + pageSize - 1) / pageSize * pageSize,
+                                       pageSize);
+        void* memory = mmap(nullptr, bytes_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (memory == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        data_ = static_cast<T*>(memory);
+        if (nodeOf) {
+            bind(nodeOf, pageSize);
+        }
+        for (int i = 0; i < size_; i++) {
+            new (&data_[i]) T();
+        }
+    }
+
+    ~NumaArray() {
+        std::destroy_n(data_, size_);
+        munmap(data_, bytes_);
+    }
+
+    NumaArray(const NumaArray&) = delete;
+    NumaArray& operator=(const NumaArray&) = delete;
+
+    T& operator[](const int index) { return data_[index]; }
+    const T& operator[](const int index) const { return data_[index]; }
+
+private:
+    // Binds runs of consecutive pages that map to the same node
+    void bind(const std::function<int(int)>& nodeOf, const std::size_t pageSize) {
+        const std::size_t pages = bytes_ / pageSize;
+        std::vector<int> pageNodes(pages, -1);
+        for (std::size_t page = 0; page < pages; page++) {
+            const std::size_t first = page * pageSize / sizeof(T);
+            if (first < static_cast<std::size_t>(size_)) {
+                pageNodes[page] = nodeOf(static_cast<int>(first));
+            }
+        }
+        std::size_t runStart = 0;
+        for (std::size_t page = 1; page <= pages; page++) {
+            if (page < pages && pageNodes[page] == pageNodes[runStart]) {
+                continue;
+            }
+            const int node = pageNodes[runStart];
+            if (node >= 0 && node < static_cast<int>(sizeof(unsigned long) * 8)) {
+                const unsigned long mask = 1UL << node;
+                // Best effort: a refused policy leaves the default placement
+                syscall(SYS_mbind, reinterpret_cast<char*>(data_) + runStart * pageSize, (page - runStart) * pageSize,
+                        MPOL_PREFERRED, &mask, sizeof(mask) * 8, 0);
+            }
+            runStart = page;
+        }
+    }
+
+    T* data_ = nullptr;
+    int size_;
+    std::size_t bytes_ = 0;
+};
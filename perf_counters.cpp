@@ -0,0 +1,213 @@
+#include "perf_counters.h"
+
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace {
+
+struct CounterEvent {
+    std::uint32_t type;
+    std::uint64_t config;
+    bool kernelOnly;  // Happens in the kernel, so a user-space count is always zero
+};
+
+CounterEvent eventOf(const PerfCounter counter) {
+    switch (counter) {
+        case PerfCounter::Cycles:
+            return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, false};
+        case PerfCounter::Instructions:
+            return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, false};
+        case PerfCounter::CacheReferences:
+            return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_REFERENCES, false};
+        case PerfCounter::CacheMisses:
+            return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, false};
+        case PerfCounter::ContextSwitches:
+            return {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES, true};
+        case PerfCounter::CpuMigrations:
+            return {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CPU_MIGRATIONS, true};
+        case PerfCounter::TaskClock:
+            return {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK, false};
+    }
+    return {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK, false};
+}
+
+// Opens the counter for the calling thread on any CPU, counting right away; -1 and errno on failure
+int openCounter(const PerfCounter counter, const bool userOnly) {
+    const CounterEvent event = eventOf(counter);
+    perf_event_attr attr{};
+    attr.size = sizeof(attr);
+    attr.type = event.type;
+    attr.config = event.config;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    attr.exclude_kernel = userOnly ? 1 : 0;
+    attr.exclude_hv = 1;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC));
+}
+
+std::string paranoidLevel() {
+    std::ifstream file("/proc/sys/kernel/perf_event_paranoid");
+    std::string level;
+    return file >> level ? level : "unknown";
+}
+
+std::string refusal(const int error) {
+    switch (error) {
+        case ENOENT:
+        case ENODEV:
+        case EOPNOTSUPP:
+            return "not supported on this machine (no PMU, or a VM that does not expose it)";
+        case EACCES:
+        case EPERM:
+            return "not permitted with kernel.perf_event_paranoid = " + paranoidLevel();
+        case ENOSYS:
+            return "perf_event_open is not available";
+        default:
+            return std::strerror(error);
+    }
+}
+
+struct Reading {
+    std::uint64_t value = 0;
+    std::uint64_t timeEnabled = 0;
+    std::uint64_t timeRunning = 0;
+};
+
+bool readCounter(const int fd, Reading& reading) {
+    return fd >= 0 && ::read(fd, &reading, sizeof(reading)) == static_cast<ssize_t>(sizeof(reading));
+}
+
+}  // namespace
+
+std::string perfCounterName(const PerfCounter counter) {
+    switch (counter) {
+        case PerfCounter::Cycles:
+            return "cycles";
+        case PerfCounter::Instructions:
+            return "instructions";
+        case PerfCounter::CacheReferences:
+            return "cache_references";
+        case PerfCounter::CacheMisses:
+            return "cache_misses";
+        case PerfCounter::ContextSwitches:
+            return "context_switches";
+        case PerfCounter::CpuMigrations:
+            return "cpu_migrations";
+        case PerfCounter::TaskClock:
+            return "task_clock_ns";
+    }
+    return "unknown";
+}
+
+PerfCollector::PerfCollector() {
+    for (int i = 0; i < NUM_PERF_COUNTERS; i++) {
+        const auto counter = static_cast<PerfCounter>(i);
+        Probe& probe = probes_[i];
+        int fd = openCounter(counter, false);
+        if (fd < 0 && (errno == EACCES || errno == EPERM)) {
+            if (eventOf(counter).kernelOnly) {
+                probe.reason = "counted in the kernel, which kernel.perf_event_paranoid = " + paranoidLevel() +
+                               " excludes";
+                continue;
+            }
+            fd = openCounter(counter, true);
+            probe.userOnly = fd >= 0;
+        }
+        if (fd < 0) {
+            probe.reason = refusal(errno);
+            continue;
+        }
+        ::close(fd);
+        probe.available = true;
+    }
+}
+
+std::optional<PerfCounter> PerfCollector::acquireCounter() const {
+    if (available(PerfCounter::Cycles)) {
+        return PerfCounter::Cycles;
+    }
+    if (available(PerfCounter::TaskClock)) {
+        return PerfCounter::TaskClock;
+    }
+    return std::nullopt;
+}
+
+void PerfCollector::add(const PerfThreadCounters& thread) {
+    std::array<std::uint64_t, NUM_PERF_COUNTERS> counts{};
+    for (int i = 0; i < NUM_PERF_COUNTERS; i++) {
+        counts[i] = thread.read(static_cast<PerfCounter>(i));
+    }
+    const std::lock_guard<std::mutex> lock(mutex_);
+    for (int i = 0; i < NUM_PERF_COUNTERS; i++) {
+        totals_[i] += counts[i];
+    }
+    acquireTotal_ += thread.acquireTotal();
+    threads_++;
+}
+
+std::uint64_t PerfCollector::total(const PerfCounter counter) const {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    return totals_[index(counter)];
+}
+
+std::uint64_t PerfCollector::acquireTotal() const {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    return acquireTotal_;
+}
+
+int PerfCollector::threads() const {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    return threads_;
+}
+
+PerfThreadCounters::PerfThreadCounters(const PerfCollector& collector) {
+    fds_.fill(-1);
+    for (int i = 0; i < NUM_PERF_COUNTERS; i++) {
+        const auto counter = static_cast<PerfCounter>(i);
+        if (collector.available(counter)) {
+            fds_[i] = openCounter(counter, collector.userOnly(counter));
+        }
+    }
+    if (const auto counter = collector.acquireCounter()) {
+        acquireFd_ = fds_[PerfCollector::index(*counter)];
+    }
+}
+
+PerfThreadCounters::~PerfThreadCounters() {
+    for (const int fd : fds_) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+}
+
+std::uint64_t PerfThreadCounters::read(const PerfCounter counter) const {
+    Reading reading;
+    if (!readCounter(fds_[PerfCollector::index(counter)], reading) || reading.timeRunning == 0) {
+        return 0;
+    }
+    if (reading.timeRunning >= reading.timeEnabled) {
+        return reading.value;
+    }
+    // Multiplexed with other counters: extrapolate to the whole time enabled
+    return static_cast<std::uint64_t>(static_cast<double>(reading.value) * static_cast<double>(reading.timeEnabled) /
+                                      static_cast<double>(reading.timeRunning));
+}
+
+void PerfThreadCounters::beginAcquire() {
+    Reading reading;
+    if (readCounter(acquireFd_, reading)) {
+        acquireStart_ = reading.value;
+    }
+}
+
+void PerfThreadCounters::endAcquire() {
+    Reading reading;
+    if (readCounter(acquireFd_, reading) && reading.value >= acquireStart_) {
+        acquireTotal_ += reading.value - acquireStart_;
+    }
+}
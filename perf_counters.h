@@ -0,0 +1,120 @@
+/*
+    PerfCounters
+    ------------
+    Hardware and software performance counters of the philosopher threads, read through
+    Linux perf_event_open(2), for --perf-counters.
+
+    The PerfCollector probes every counter once on the thread that creates it. A counter the
+    kernel refuses stays off for the whole run, with the reason, so the same binary runs on
+    a VM without a PMU or under a strict kernel.perf_event_paranoid and reports what it
+    could measure instead of failing. Counting excludes the kernel when only that is allowed
+    (paranoid 2 without CAP_PERFMON); context switches and migrations happen in the kernel
+    and are then unavailable.
+
+    Every philosopher thread opens its own counters (PerfThreadCounters) when it starts and
+    adds them to the collector when it leaves the table. Around each acquire() it reads one
+    counter, cycles or else the task clock, so the report can tell the cost of picking up
+    the chopsticks from the rest of the loop. These are two read(2) calls per meal.
+*/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+
+enum class PerfCounter : std::uint8_t {
+    Cycles,
+    Instructions,
+    CacheReferences,
+    CacheMisses,
+    ContextSwitches,
+    CpuMigrations,
+    TaskClock,  // CPU time of the thread, in ns
+};
+
+constexpr int NUM_PERF_COUNTERS = 7;
+
+/*
+    Function: perfCounterName
+    -------------------------
+    Returns the name of a counter in the reports, e.g. "cache_misses".
+*/
+std::string perfCounterName(PerfCounter counter);
+
+class PerfThreadCounters;
+
+class PerfCollector {
+public:
+    // Probes which counters the kernel grants this process
+    PerfCollector();
+
+    bool available(PerfCounter counter) const { return probes_[index(counter)].available; }
+
+    // Why a counter is unavailable; empty if it is available
+    const std::string& unavailableReason(PerfCounter counter) const { return probes_[index(counter)].reason; }
+
+    // The counter counts user space only
+    bool userOnly(PerfCounter counter) const { return probes_[index(counter)].userOnly; }
+
+    // Counter read around acquire(): cycles, else the task clock, else none
+    std::optional<PerfCounter> acquireCounter() const;
+
+    // Adds the counts of a thread that is done; thread-safe
+    void add(const PerfThreadCounters& thread);
+
+    // Sums over the threads added so far
+    std::uint64_t total(PerfCounter counter) const;
+    std::uint64_t acquireTotal() const;  // Of acquireCounter(), inside acquire()
+    int threads() const;
+
+private:
+    struct Probe {
+        bool available = false;
+        bool userOnly = false;
+        std::string reason;
+    };
+
+    static std::size_t index(const PerfCounter counter) { return static_cast<std::size_t>(counter); }
+
+    friend class PerfThreadCounters;
+
+    std::array<Probe, NUM_PERF_COUNTERS> probes_;
+
+    mutable std::mutex mutex_;
+    std::array<std::uint64_t, NUM_PERF_COUNTERS> totals_{};
+    std::uint64_t acquireTotal_ = 0;
+    int threads_ = 0;
+};
+
+/*
+    Class: PerfThreadCounters
+    -------------------------
+    The available counters of the calling thread, counting from construction until
+    destruction. Must stay on the thread that created it.
+*/
+class PerfThreadCounters {
+public:
+    explicit PerfThreadCounters(const PerfCollector& collector);
+    ~PerfThreadCounters();
+
+    PerfThreadCounters(const PerfThreadCounters&) = delete;
+    PerfThreadCounters& operator=(const PerfThreadCounters&) = delete;
+
+    // Current value, scaled up if the kernel multiplexed the counter; 0 if it is not open
+    std::uint64_t read(PerfCounter counter) const;
+
+    // Bracket one acquire() for PerfCollector::acquireTotal()
+    void beginAcquire();
+    void endAcquire();
+
+    std::uint64_t acquireTotal() const { return acquireTotal_; }
+
+private:
+    std::array<int, NUM_PERF_COUNTERS> fds_;
+    int acquireFd_ = -1;
+    std::uint64_t acquireStart_ = 0;
+    std::uint64_t acquireTotal_ = 0;
+};
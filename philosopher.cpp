@@ -0,0 +1,388 @@
+#include "philosopher.h"
+#include "coroutine_philosopher.h"
+#include "logger.h"
+#include "static_table.h"
+#include "task_philosopher.h"
+
+#include <algorithm>
+#include <csignal>
+#include <functional>
+#include <optional>
+#include <random>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <sys/resource.h>
+
+namespace {
+
+volatile std::sig_atomic_t interruptRequested = 0;
+
+extern "C" void onInterruptSignal(int) {
+    interruptRequested = 1;
+}
+
+}  // namespace
+
+DiningTable::DiningTable(const Config& config)
+    : numPhilosophers(config.numPhilosophers),
+      placement(config.placement, config.placement == PlacementPolicy::None ? std::vector<CpuInfo>{} : readCpuTopology()),
+      strategyKind(config.strategy),
+      philosopherLoop(philosopher),
+      thinkModels(config.numPhilosophers, config.think),
+      eatModels(config.numPhilosophers, config.eat),
+      seed(config.seed),
+      mealLimit(config.meals),
+      courses(config.courses),
+      stats(std::make_unique<PhilosopherStats[]>(config.numPhilosophers)),
+      perf(config.perfCounters ? std::make_unique<PerfCollector>() : nullptr) {
+    if (config.executor == Executor::Threads && config.mode != Mode::Des) {
+        std::tie(strategy, philosopherLoop) = specializedTable(config);
+        staticTable = strategy != nullptr;
+        if (!staticTable) {
+            strategy = makeStrategy(config.strategy, config.chopstick, config.numPhilosophers,
+                                    [this](const int chopstick) { return placement.nodeFor(chopstick, numPhilosophers); },
+                                    config.backoff, config.seed);
+            philosopherLoop = philosopher;
+        }
+    }
+    for (const auto& [id, model] : config.thinkOverrides) {
+        thinkModels[id] = model;
+    }
+    for (const auto& [id, model] : config.eatOverrides) {
+        eatModels[id] = model;
+    }
+}
+
+Seat seatOf(const DiningTable& table, const int philosopherID) {
+    return Seat{
+        philosopherID,
+        philosopherID,                                // Left chopstick for the philosopher
+        (philosopherID + 1) % table.numPhilosophers   // Right chopstick for the philosopher
+    };
+}
+
+std::chrono::steady_clock::time_point startHungryWait(PhilosopherStats& stats) {
+    const auto now = std::chrono::steady_clock::now();
+    stats.hungrySinceNs.store(std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count(),
+                              std::memory_order_relaxed);
+    return now;
+}
+
+void recordAcquisition(PhilosopherStats& stats, const std::chrono::steady_clock::time_point hungrySince,
+                       const std::chrono::steady_clock::time_point acquired) {
+    stats.hungrySinceNs.store(0, std::memory_order_relaxed);
+    if (stats.waitPublished) {
+        stats.waitState.store(0, std::memory_order_relaxed);
+        stats.waitPublished = false;
+    }
+    const auto waitNs = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(acquired - hungrySince).count());
+    stats.hungryWait.record(waitNs);
+    bump(stats.liveWaitBuckets[liveWaitBucketOf(waitNs)]);
+    bump(stats.hungryNs, waitNs);
+    raiseMax(stats.maxWaitNs, waitNs);
+    if (stats.chopsticksHeld > 0) {
+        bump(stats.halfHeldNs, static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(acquired - stats.firstPickedUp).count()));
+    }
+    stats.chopsticksHeld = 0;
+}
+
+bool eatAnotherCourse(const DiningTable& table, const int philosopherID, const int coursesEaten) {
+    if (coursesEaten >= table.courses.maxCourses) {
+        return false;
+    }
+    const std::uint64_t meals = table.stats[philosopherID].meals.load(std::memory_order_relaxed);
+    if (table.mealLimit != 0 && meals >= table.mealLimit) {
+        return false;
+    }
+    if (!table.courses.adaptive) {
+        return true;
+    }
+    const int left = (philosopherID + table.numPhilosophers - 1) % table.numPhilosophers;
+    const int right = (philosopherID + 1) % table.numPhilosophers;
+    return table.stats[left].hungrySinceNs.load(std::memory_order_relaxed) == 0 &&
+           table.stats[right].hungrySinceNs.load(std::memory_order_relaxed) == 0;
+}
+
+/*
+    Function: think
+    ----------------
+    Simulates the thinking process of a philosopher.
+
+    Parameters:
+    - philosopherID: the ID of the philosopher.
+    - rng: the philosopher's random stream.
+    - stop: cuts the thinking short when the run is over.
+
+    This function simulates the philosopher thinking for a period drawn from its think model.
+*/
+void think(const DiningTable& table, const int philosopherID, std::mt19937_64& rng, const std::stop_token& stop) {
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    logEvent(philosopherID, Event::Thinking);
+    table.thinkModels[philosopherID].apply(rng, stop);  // Simulate thinking time
+
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
+
+    // Log the completion of the thinking process with the duration
+    logEvent(philosopherID, Event::Thought, -1, duration);
+}
+
+/*
+    Function: eat
+    --------------
+    Simulates the eating process of a philosopher.
+
+    Parameters:
+    - philosopherID: the ID of the philosopher.
+    - rng: the philosopher's random stream.
+    - stop: cuts the meal short when the run is over.
+
+    This function simulates the philosopher eating for a period drawn from its eat model.
+*/
+void eat(const DiningTable& table, const int philosopherID, std::mt19937_64& rng, const std::stop_token& stop) {
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    logEvent(philosopherID, Event::Eating);
+    table.eatModels[philosopherID].apply(rng, stop);  // Simulate eating time
+
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
+
+    // Log the completion of the eating process with the duration
+    logEvent(philosopherID, Event::Ate, -1, duration);
+}
+
+namespace {
+
+/*
+    Function: philosopherOn
+    -----------------------
+    Controls the actions of each philosopher: alternating between thinking and eating.
+
+    Parameters:
+    - stop: ends the loop; checked between steps and honoured while blocked on a chopstick.
+    - strategy: the table's strategy; a StaticTable when instantiated for one, so that its
+      calls bind statically.
+    - philosopherID: the ID of the philosopher.
+
+    Each philosopher tries to pick up their chopsticks through the selected acquisition
+    strategy. With the default asymmetric strategy, odd philosophers pick up their left
+    chopstick first, and even philosophers pick up their right chopstick first to avoid deadlock.
+    The time from becoming hungry until both chopsticks are held is recorded per acquisition,
+    which is followed by one or more courses (see eatAnotherCourse), each counted as a meal.
+    A meal cut short by the stop still counts, since the chopsticks were held.
+*/
+template <typename Strategy>
+void philosopherOn(const std::stop_token& stop, DiningTable& table, Strategy& strategy, const int philosopherID) {
+    PhilosopherStats& stats = table.stats[philosopherID];
+    Seat seat = seatOf(table, philosopherID);
+    seat.stats = &stats;
+    std::mt19937_64 rng(table.seed * 0x9e3779b97f4a7c15ULL + static_cast<std::uint64_t>(philosopherID));
+    if (table.placement.pinCurrentThread(philosopherID, table.numPhilosophers)) {
+        table.pinned.fetch_add(1, std::memory_order_relaxed);
+    }
+    std::optional<PerfThreadCounters> counters;
+    if (table.perf) {
+        counters.emplace(*table.perf);
+    }
+
+    // Loop alternating between thinking and eating until the run is over
+    while (!stop.stop_requested()) {
+        think(table, philosopherID, rng, stop);  // Simulate thinking process
+        if (stop.stop_requested()) {
+            break;
+        }
+
+        // Philosopher is hungry and trying to pick up chopsticks
+        logEvent(philosopherID, Event::Hungry);
+        const auto hungrySince = startHungryWait(stats);
+        if (counters) {
+            counters->beginAcquire();
+        }
+        const bool acquired = strategy.acquire(seat, stop);
+        if (counters) {
+            counters->endAcquire();
+        }
+        if (!acquired) {
+            stats.chopsticksHeld = 0;  // The strategy already put back anything picked up
+            stats.hungrySinceNs.store(0, std::memory_order_relaxed);
+            stats.waitState.store(0, std::memory_order_relaxed);
+            stats.waitPublished = false;
+            break;
+        }
+        recordAcquisition(stats, hungrySince, std::chrono::steady_clock::now());
+
+        int courses = 0;
+        do {
+            eat(table, philosopherID, rng, stop);  // Simulate eating process
+            bump(stats.meals);
+            courses++;
+        } while (!stop.stop_requested() && eatAnotherCourse(table, philosopherID, courses));
+
+        // Philosopher puts down both chopsticks after eating. Logged first, so that a
+        // neighbour's pick-up is never stamped before this put-down.
+        logEvent(philosopherID, Event::PutDown);
+        strategy.release(seat);
+
+        if (table.mealLimit != 0 && stats.meals.load(std::memory_order_relaxed) >= table.mealLimit) {
+            table.finished.fetch_add(1, std::memory_order_release);
+            break;
+        }
+    }
+
+    if (counters) {
+        table.perf->add(*counters);
+    }
+}
+
+template <typename Table>
+void staticPhilosopher(std::stop_token stop, DiningTable& table, const int philosopherID) {
+    philosopherOn(stop, table, static_cast<Table&>(*table.strategy), philosopherID);
+}
+
+template <int N, StrategyKind Kind, typename Chopstick>
+std::pair<std::unique_ptr<AcquisitionStrategy>, PhilosopherLoop> specializeAs() {
+    using Table = StaticTable<N, Kind, Chopstick>;
+    auto strategy = Table::create();
+    if (strategy == nullptr) {
+        return {nullptr, nullptr};
+    }
+    return {std::move(strategy), staticPhilosopher<Table>};
+}
+
+template <int N, StrategyKind Kind>
+std::pair<std::unique_ptr<AcquisitionStrategy>, PhilosopherLoop> specializeChopstick(const ChopstickKind chopstick) {
+    switch (chopstick) {
+        case ChopstickKind::Semaphore:
+            return specializeAs<N, Kind, PaddedChopstick>();
+        case ChopstickKind::SpinPark:
+            return specializeAs<N, Kind, SpinParkChopstick>();
+        case ChopstickKind::Ticket:
+            return specializeAs<N, Kind, TicketChopstick>();
+    }
+    return {nullptr, nullptr};
+}
+
+template <int N>
+std::pair<std::unique_ptr<AcquisitionStrategy>, PhilosopherLoop> specializeStrategy(const Config& config) {
+    switch (config.strategy) {
+        case StrategyKind::Asymmetric:
+            return specializeChopstick<N, StrategyKind::Asymmetric>(config.chopstick);
+        case StrategyKind::Hierarchy:
+            return specializeChopstick<N, StrategyKind::Hierarchy>(config.chopstick);
+        default:
+            return {nullptr, nullptr};
+    }
+}
+
+}  // namespace
+
+std::pair<std::unique_ptr<AcquisitionStrategy>, PhilosopherLoop> specializedTable(const Config& config) {
+    if (!config.staticTable || config.executor != Executor::Threads || config.placement != PlacementPolicy::None) {
+        return {nullptr, nullptr};
+    }
+    switch (config.numPhilosophers) {
+        case 5:
+            return specializeStrategy<5>(config);
+        case 16:
+            return specializeStrategy<16>(config);
+        case 64:
+            return specializeStrategy<64>(config);
+        case 1024:
+            return specializeStrategy<1024>(config);
+        default:
+            return {nullptr, nullptr};
+    }
+}
+
+void philosopher(std::stop_token stop, DiningTable& table, const int philosopherID) {
+    philosopherOn(stop, table, *table.strategy, philosopherID);
+}
+
+void waitForRunEnd(const DiningTable& table, const std::chrono::steady_clock::time_point start,
+                   const std::chrono::milliseconds duration) {
+    waitForRunEnd(table.finished, table.numPhilosophers, start, duration);
+}
+
+void waitForRunEnd(const std::atomic<int>& finishedWorkers, const int numWorkers,
+                   const std::chrono::steady_clock::time_point start, const std::chrono::milliseconds duration) {
+    constexpr auto POLL = std::chrono::milliseconds(10);
+
+    interruptRequested = 0;
+    const auto previousInt = std::signal(SIGINT, onInterruptSignal);
+    const auto previousTerm = std::signal(SIGTERM, onInterruptSignal);
+
+    const bool timed = duration > std::chrono::milliseconds::zero();
+    const auto deadline = start + duration;
+    while (interruptRequested == 0 && finishedWorkers.load(std::memory_order_acquire) < numWorkers) {
+        auto wait = POLL;
+        if (timed) {
+            const auto now = std::chrono::steady_clock::now();
+            if (now >= deadline) {
+                break;
+            }
+            wait = std::min(wait, std::chrono::ceil<std::chrono::milliseconds>(deadline - now));
+        }
+        std::this_thread::sleep_for(wait);
+    }
+
+    std::signal(SIGINT, previousInt);
+    std::signal(SIGTERM, previousTerm);
+}
+
+RunResult runPhilosophers(DiningTable& table, const std::chrono::milliseconds duration) {
+    // Philosopher threads
+    std::vector<std::jthread> philosophers;
+    philosophers.reserve(table.numPhilosophers);
+
+    // Create and launch philosopher threads
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < table.numPhilosophers; i++) {
+        philosophers.emplace_back(table.philosopherLoop, std::ref(table), i);  // Each thread simulates a philosopher
+    }
+
+    waitForRunEnd(table, start, duration);
+
+    // Stop everyone, then join: a philosopher blocked on a chopstick gives up its wait
+    for (auto& thread : philosophers) {
+        thread.request_stop();
+    }
+    philosophers.clear();
+
+    RunResult result;
+    result.elapsed = std::chrono::steady_clock::now() - start;
+    result.workers = table.numPhilosophers;
+    return result;
+}
+
+RunResult runTable(DiningTable& table, const Config& config) {
+    const std::chrono::milliseconds duration(config.durationMs);
+
+    rusage before{};
+    getrusage(RUSAGE_SELF, &before);
+
+    RunResult result;
+    switch (config.executor) {
+        case Executor::Threads:
+            result = runPhilosophers(table, duration);
+            break;
+        case Executor::Pool:
+            result = runPhilosopherTasks(table, duration, config.threads);
+            break;
+        case Executor::Coroutine:
+            result = runPhilosopherCoroutines(table, duration);
+            break;
+    }
+
+    rusage after{};
+    getrusage(RUSAGE_SELF, &after);
+    result.voluntaryContextSwitches = static_cast<std::uint64_t>(after.ru_nvcsw - before.ru_nvcsw);
+    result.involuntaryContextSwitches = static_cast<std::uint64_t>(after.ru_nivcsw - before.ru_nivcsw);
+    return result;
+}
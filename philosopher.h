@@ -0,0 +1,157 @@
+/*
+    Philosopher
+    -----------
+    The dining table shared by all philosopher threads, and the philosopher loop itself.
+*/
+
+#pragma once
+
+#include "config.h"
+#include "duration.h"
+#include "metrics.h"
+#include "perf_counters.h"
+#include "placement.h"
+#include "strategy.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <stop_token>
+#include <utility>
+#include <vector>
+
+struct DiningTable;
+
+// A philosopher thread's body: philosopher(), or its instantiation on a static table
+using PhilosopherLoop = void (*)(std::stop_token, DiningTable&, int);
+
+struct DiningTable {
+    explicit DiningTable(const Config& config);
+
+    int numPhilosophers;
+
+    // Where the philosopher threads (or pool workers) run, and where the chopsticks live
+    Placement placement;
+    std::atomic<int> pinned{0};  // Threads pinned to a CPU by the placement
+
+    // Chopstick acquisition strategy shared by all philosopher threads. It owns the chopstick
+    // table, allocated once the number of philosophers is known, with every chopstick on its
+    // own cache line to avoid false sharing between neighbours, and chopstick i on the NUMA
+    // node of philosopher i. Not created for the task executors and the discrete-event
+    // simulation, which keep their own chopsticks.
+    std::unique_ptr<AcquisitionStrategy> strategy;
+    StrategyKind strategyKind;
+
+    // For the common table sizes (see specializedTable()), unless --static-table=off, the
+    // strategy is a StaticTable (see static_table.h) and the threads run the philosopher loop
+    // instantiated on it, which calls the strategy without virtual dispatch.
+    PhilosopherLoop philosopherLoop;
+    bool staticTable = false;
+
+    // Think/eat duration models, indexed by philosopher ID
+    std::vector<DurationModel> thinkModels;
+    std::vector<DurationModel> eatModels;
+    std::uint64_t seed;       // Base seed of the per-philosopher random streams
+    std::uint64_t mealLimit;  // Meals per philosopher before it leaves the table (0 = unlimited)
+    CoursePolicy courses;     // Courses eaten per acquisition; every course counts as a meal
+
+    std::atomic<int> finished{0};  // Philosophers that left the table on their own (meal limit)
+
+    std::unique_ptr<PhilosopherStats[]> stats;  // Indexed by philosopher ID
+
+    // Per-thread perf_event counters of the philosopher threads (--perf-counters), or null
+    std::unique_ptr<PerfCollector> perf;
+};
+
+/*
+    Function: seatOf
+    ----------------
+    Returns the seat of a philosopher: chopstick i on the left, chopstick i + 1 on the right.
+*/
+Seat seatOf(const DiningTable& table, int philosopherID);
+
+/*
+    Function: startHungryWait
+    -------------------------
+    Marks the philosopher hungry for the watchdog and returns the start of the wait.
+*/
+std::chrono::steady_clock::time_point startHungryWait(PhilosopherStats& stats);
+
+/*
+    Function: recordAcquisition
+    ---------------------------
+    Updates the philosopher's counters once both chopsticks are held, ending the wait.
+*/
+void recordAcquisition(PhilosopherStats& stats, std::chrono::steady_clock::time_point hungrySince,
+                       std::chrono::steady_clock::time_point acquired);
+
+/*
+    Function: eatAnotherCourse
+    --------------------------
+    Decides, after a course, whether the philosopher keeps both chopsticks and eats another
+    one before putting them down. coursesEaten counts the courses since the chopsticks were
+    picked up, the finished one included. The meal ends at the course limit, at the meal
+    limit and, with adaptive batching, as soon as a neighbour is hungry: the neighbours
+    publish their waits in PhilosopherStats::hungrySinceNs, so checking costs two loads.
+*/
+bool eatAnotherCourse(const DiningTable& table, int philosopherID, int coursesEaten);
+
+/*
+    Function: specializedTable
+    --------------------------
+    Returns a StaticTable strategy and the philosopher loop instantiated on it when the
+    configuration has one: threads executor, no NUMA placement, asymmetric or hierarchy
+    strategy, and 5, 16, 64 or 1024 philosophers. Returns {nullptr, nullptr} otherwise, or
+    when the table of that instantiation is already in use.
+*/
+std::pair<std::unique_ptr<AcquisitionStrategy>, PhilosopherLoop> specializedTable(const Config& config);
+
+/*
+    Function: philosopher
+    ---------------------
+    Runs one philosopher until a stop is requested on the token or the meal limit is reached.
+    The stop is honoured while thinking, eating or blocked on a chopstick.
+*/
+void philosopher(std::stop_token stop, DiningTable& table, int philosopherID);
+
+// Outcome of a run
+struct RunResult {
+    std::chrono::nanoseconds elapsed{0};
+    int workers = 0;           // OS threads that ran philosophers
+    std::uint64_t steals = 0;  // Tasks taken over by another pool worker (pool executor)
+    // Context switches of the whole process during the run
+    std::uint64_t voluntaryContextSwitches = 0;
+    std::uint64_t involuntaryContextSwitches = 0;
+};
+
+/*
+    Function: waitForRunEnd
+    -----------------------
+    Blocks until the first of:
+    - the wall-time limit, counted from start, has passed (duration of zero means no limit),
+    - every philosopher has reached the meal limit,
+    - the process received SIGINT or SIGTERM (handled for the duration of the wait).
+*/
+void waitForRunEnd(const DiningTable& table, std::chrono::steady_clock::time_point start,
+                   std::chrono::milliseconds duration);
+
+// The same for any group of workers, finishedWorkers counting those done
+void waitForRunEnd(const std::atomic<int>& finishedWorkers, int numWorkers, std::chrono::steady_clock::time_point start,
+                   std::chrono::milliseconds duration);
+
+/*
+    Function: runPhilosophers
+    -------------------------
+    Seats every philosopher on its own std::jthread and runs the table until waitForRunEnd()
+    returns, then requests a stop and joins all philosophers.
+*/
+RunResult runPhilosophers(DiningTable& table, std::chrono::milliseconds duration);
+
+/*
+    Function: runTable
+    ------------------
+    Runs the table on the configured executor for the configured limits, and counts the
+    context switches the run caused.
+*/
+RunResult runTable(DiningTable& table, const Config& config);
@@ -0,0 +1,178 @@
+#include "placement.h"
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <tuple>
+
+#include <pthread.h>
+#include <sched.h>
+
+namespace {
+
+// Reads a single integer from a sysfs file, or the fallback
+int readNumber(const std::string& path, const int fallback) {
+    std::ifstream in(path);
+    int value = fallback;
+    if (!(in >> value)) {
+        return fallback;
+    }
+    return value;
+}
+
+// Parses a sysfs CPU list such as "0-3,8-11"
+std::vector<int> parseCpuList(const std::string& list) {
+    std::vector<int> cpus;
+    std::stringstream ranges(list);
+    std::string range;
+    while (std::getline(ranges, range, ',')) {
+        int first = 0;
+        std::stringstream bounds(range);
+        if (!(bounds >> first)) {
+            continue;
+        }
+        int last = first;
+        char separator = 0;
+        if (bounds >> separator && separator == '-') {
+            bounds >> last;
+        }
+        for (int cpu = first; cpu <= last; cpu++) {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+// NUMA node of every CPU listed under /sys/devices/system/node
+std::map<int, int> readCpuNodes() {
+    std::map<int, int> nodes;
+    const int possibleNodes = 1024;
+    for (int node = 0; node < possibleNodes; node++) {
+        std::ifstream in("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        if (!in) {
+            if (node > 0 && nodes.empty()) {
+                break;
+            }
+            continue;
+        }
+        std::string list;
+        std::getline(in, list);
+        for (const int cpu : parseCpuList(list)) {
+            nodes[cpu] = node;
+        }
+    }
+    return nodes;
+}
+
+}  // namespace
+
+const char* placementName(const PlacementPolicy policy) {
+    switch (policy) {
+        case PlacementPolicy::None:
+            return "none";
+        case PlacementPolicy::Compact:
+            return "compact";
+        case PlacementPolicy::Scatter:
+            return "scatter";
+    }
+    return "unknown";
+}
+
+std::vector<CpuInfo> readCpuTopology() {
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+        return {};
+    }
+    const std::map<int, int> nodes = readCpuNodes();
+
+    std::vector<CpuInfo> cpus;
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (!CPU_ISSET(cpu, &allowed)) {
+            continue;
+        }
+        const std::string base = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+        CpuInfo info{};
+        info.cpu = cpu;
+        const auto node = nodes.find(cpu);
+        info.node = node == nodes.end() ? 0 : node->second;
+        info.package = readNumber(base + "/topology/physical_package_id", 0);
+        info.l3 = readNumber(base + "/cache/index3/id", info.package);
+        info.core = readNumber(base + "/topology/core_id", cpu);
+        cpus.push_back(info);
+    }
+    return cpus;
+}
+
+Placement::Placement(const PlacementPolicy policy, std::vector<CpuInfo> cpus) : policy_(policy) {
+    if (policy == PlacementPolicy::None || cpus.empty()) {
+        policy_ = PlacementPolicy::None;
+        return;
+    }
+    // Compact order: hardware threads of a core, cores of an L3, L3s of a node, nodes
+    std::sort(cpus.begin(), cpus.end(), [](const CpuInfo& a, const CpuInfo& b) {
+        return std::tie(a.node, a.package, a.l3, a.core, a.cpu) < std::tie(b.node, b.package, b.l3, b.core, b.cpu);
+    });
+
+    // Sockets are the NUMA nodes, or the packages when the machine reports a single node
+    std::set<int> nodeIDs;
+    for (const CpuInfo& cpu : cpus) {
+        nodeIDs.insert(cpu.node);
+    }
+    numNodes_ = static_cast<int>(nodeIDs.size());
+
+    if (policy == PlacementPolicy::Compact) {
+        order_ = std::move(cpus);
+        return;
+    }
+
+    // Scatter: deal the sockets' CPUs out in turn, each socket in its compact order
+    const bool byNode = nodeIDs.size() > 1;
+    std::map<int, std::vector<CpuInfo>> sockets;
+    for (const CpuInfo& cpu : cpus) {
+        sockets[byNode ? cpu.node : cpu.package].push_back(cpu);
+    }
+    for (std::size_t round = 0; order_.size() < cpus.size(); round++) {
+        for (const auto& [socket, members] : sockets) {
+            if (round < members.size()) {
+                order_.push_back(members[round]);
+            }
+        }
+    }
+}
+
+const CpuInfo* Placement::slot(const int index, const int count) const {
+    if (policy_ == PlacementPolicy::None || order_.empty() || count <= 0) {
+        return nullptr;
+    }
+    const auto cpus = static_cast<long long>(order_.size());
+    // Compact keeps contiguous seats together when there are more seats than CPUs;
+    // scatter keeps dealing them round-robin
+    const long long position = policy_ == PlacementPolicy::Compact && count > cpus
+                                   ? static_cast<long long>(index) * cpus / count
+                                   : index % cpus;
+    return &order_[static_cast<std::size_t>(position)];
+}
+
+int Placement::cpuFor(const int index, const int count) const {
+    const CpuInfo* cpu = slot(index, count);
+    return cpu == nullptr ? -1 : cpu->cpu;
+}
+
+int Placement::nodeFor(const int index, const int count) const {
+    const CpuInfo* cpu = slot(index, count);
+    return cpu == nullptr ? -1 : cpu->node;
+}
+
+bool Placement::pinCurrentThread(const int index, const int count) const {
+    const int cpu = cpuFor(index, count);
+    if (cpu < 0) {
+        return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
@@ -0,0 +1,76 @@
+/*
+    Placement
+    ---------
+    CPU topology and thread placement policies.
+
+    The topology is read from sysfs (/sys/devices/system/cpu and /sys/devices/system/node)
+    and limited to the CPUs this process may run on. A policy maps slot i of n (a
+    philosopher seat, or a pool worker) to one CPU:
+    - none:    no affinity; the scheduler places the threads.
+    - compact: CPUs ordered by NUMA node, L3 domain, core and hardware thread, filled in
+               order, so neighbouring seats, which share a chopstick, share a core or at
+               least an L3 and a node. With more seats than CPUs, contiguous blocks of
+               seats share a CPU.
+    - scatter: seats dealt round-robin across the NUMA nodes (sockets on machines without
+               NUMA information), so neighbours sit on different sockets. The worst case,
+               measured for comparison.
+    The NUMA node of a slot is also used to place chopstick memory (see numa_array.h).
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+enum class PlacementPolicy {
+    None,
+    Compact,
+    Scatter
+};
+
+// Command-line name of a placement policy
+const char* placementName(PlacementPolicy policy);
+
+struct CpuInfo {
+    int cpu;      // Logical CPU number
+    int node;     // NUMA node (0 without NUMA information)
+    int package;  // Physical socket
+    int l3;       // L3 cache domain (the package without L3 information)
+    int core;     // Physical core within the package
+};
+
+/*
+    Function: readCpuTopology
+    -------------------------
+    The CPUs of the process's affinity mask with their node, package, L3 and core. Missing
+    sysfs entries count as 0, so the result is always usable.
+*/
+std::vector<CpuInfo> readCpuTopology();
+
+class Placement {
+public:
+    // No pinning
+    Placement() = default;
+    Placement(PlacementPolicy policy, std::vector<CpuInfo> cpus);
+
+    PlacementPolicy policy() const { return policy_; }
+
+    // NUMA nodes among the CPUs in use
+    int numNodes() const { return numNodes_; }
+
+    // CPU of slot index out of count, or -1 without pinning
+    int cpuFor(int index, int count) const;
+
+    // NUMA node of that CPU, or -1 without pinning
+    int nodeFor(int index, int count) const;
+
+    // Pins the calling thread to cpuFor(index, count). False if unpinned or refused.
+    bool pinCurrentThread(int index, int count) const;
+
+private:
+    const CpuInfo* slot(int index, int count) const;
+
+    PlacementPolicy policy_ = PlacementPolicy::None;
+    std::vector<CpuInfo> order_;  // CPUs in the order slots are assigned
+    int numNodes_ = 1;
+};
@@ -0,0 +1,258 @@
+#include "resource_graph.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_set>
+
+namespace {
+
+// Restarts of the random pairing before giving up on a degree sequence
+constexpr int RANDOM_GRAPH_ATTEMPTS = 100;
+
+int parseCount(const std::string& text, const std::string& spec) {
+    std::size_t consumed = 0;
+    long long value = 0;
+    try {
+        value = std::stoll(text, &consumed);
+    } catch (const std::exception&) {
+        consumed = 0;
+    }
+    if (consumed == 0 || consumed != text.size() || value < 1 || value > 100'000'000) {
+        throw std::invalid_argument("invalid topology spec '" + spec + "'");
+    }
+    return static_cast<int>(value);
+}
+
+}  // namespace
+
+TopologySpec TopologySpec::parse(const std::string& spec) {
+    const std::size_t colon = spec.find(':');
+    const std::string kind = spec.substr(0, colon);
+    const std::string argument = colon == std::string::npos ? "" : spec.substr(colon + 1);
+
+    TopologySpec topology;
+    if (kind == "ring" && colon == std::string::npos) {
+        topology.kind = Kind::Ring;
+    } else if (kind == "grid" && !argument.empty()) {
+        const std::size_t times = argument.find('x');
+        if (times == std::string::npos) {
+            throw std::invalid_argument("invalid topology spec '" + spec + "'");
+        }
+        topology.kind = Kind::Grid;
+        topology.rows = parseCount(argument.substr(0, times), spec);
+        topology.columns = parseCount(argument.substr(times + 1), spec);
+    } else if (kind == "random" && !argument.empty()) {
+        topology.kind = Kind::Random;
+        topology.degree = parseCount(argument, spec);
+    } else if (kind == "file" && !argument.empty()) {
+        topology.kind = Kind::File;
+        topology.path = argument;
+    } else {
+        throw std::invalid_argument("invalid topology spec '" + spec + "'");
+    }
+    return topology;
+}
+
+std::string TopologySpec::describe() const {
+    switch (kind) {
+        case Kind::Ring:
+            return "ring";
+        case Kind::Grid:
+            return "grid:" + std::to_string(rows) + "x" + std::to_string(columns);
+        case Kind::Random:
+            return "random:" + std::to_string(degree);
+        case Kind::File:
+            return "file:" + path;
+    }
+    return "unknown";
+}
+
+ResourceGraph ResourceGraph::build(const TopologySpec& spec, const int numWorkers, const std::uint64_t seed) {
+    switch (spec.kind) {
+        case TopologySpec::Kind::Ring:
+            return ring(numWorkers);
+        case TopologySpec::Kind::Grid:
+            return grid(spec.rows, spec.columns);
+        case TopologySpec::Kind::Random:
+            return randomRegular(numWorkers, spec.degree, seed);
+        case TopologySpec::Kind::File:
+            return fromFile(spec.path);
+    }
+    throw std::invalid_argument("unknown topology");
+}
+
+ResourceGraph ResourceGraph::ring(const int numWorkers) {
+    std::vector<std::pair<int, int>> memberships;
+    memberships.reserve(2 * static_cast<std::size_t>(numWorkers));
+    for (int worker = 0; worker < numWorkers; worker++) {
+        memberships.emplace_back(worker, worker);
+        memberships.emplace_back((worker + 1) % numWorkers, worker);
+    }
+    return fromMemberships(numWorkers, numWorkers, std::move(memberships));
+}
+
+ResourceGraph ResourceGraph::grid(const int rows, const int columns) {
+    const long long workers = static_cast<long long>(rows) * columns;
+    if (workers < 2 || workers > 100'000'000) {
+        throw std::invalid_argument("a grid needs between 2 and 100000000 workers");
+    }
+    const auto numWorkers = static_cast<int>(workers);
+
+    // Worker (r, c) owns resource 2w, the edge to its right neighbour, and 2w + 1, the edge
+    // to the neighbour below; both wrap around. A dimension of 1 makes its edge a self-loop,
+    // which leaves a resource used by one worker only.
+    std::vector<std::pair<int, int>> memberships;
+    memberships.reserve(4 * static_cast<std::size_t>(numWorkers));
+    for (int r = 0; r < rows; r++) {
+        for (int c = 0; c < columns; c++) {
+            const int worker = r * columns + c;
+            const int right = r * columns + (c + 1) % columns;
+            const int below = (r + 1) % rows * columns + c;
+            memberships.emplace_back(2 * worker, worker);
+            memberships.emplace_back(2 * worker, right);
+            memberships.emplace_back(2 * worker + 1, worker);
+            memberships.emplace_back(2 * worker + 1, below);
+        }
+    }
+    return fromMemberships(numWorkers, 2 * numWorkers, std::move(memberships));
+}
+
+ResourceGraph ResourceGraph::randomRegular(const int numWorkers, const int degree, const std::uint64_t seed) {
+    if (degree >= numWorkers) {
+        throw std::invalid_argument("a random " + std::to_string(degree) + "-regular graph needs more than " +
+                                    std::to_string(degree) + " workers");
+    }
+    if (static_cast<long long>(numWorkers) * degree % 2 != 0) {
+        throw std::invalid_argument("a random " + std::to_string(degree) + "-regular graph needs an even number of workers");
+    }
+
+    // Pairs up K stubs per worker at random, rejecting self-loops and repeated edges, and
+    // starts over when the remaining stubs cannot be paired any more
+    std::mt19937_64 rng(seed);
+    const auto key = [numWorkers](const int a, const int b) {
+        return static_cast<std::uint64_t>(std::min(a, b)) * static_cast<std::uint64_t>(numWorkers) +
+               static_cast<std::uint64_t>(std::max(a, b));
+    };
+    for (int attempt = 0; attempt < RANDOM_GRAPH_ATTEMPTS; attempt++) {
+        std::vector<int> stubs;
+        stubs.reserve(static_cast<std::size_t>(numWorkers) * degree);
+        for (int worker = 0; worker < numWorkers; worker++) {
+            stubs.insert(stubs.end(), degree, worker);
+        }
+        std::unordered_set<std::uint64_t> edges;
+        std::vector<std::pair<int, int>> memberships;
+        memberships.reserve(stubs.size());
+
+        bool stuck = false;
+        while (!stubs.empty() && !stuck) {
+            stuck = true;
+            // Enough tries that a pairable remainder is almost never mistaken for a stuck one
+            for (std::size_t tries = 0; tries < 4 * stubs.size() + 16; tries++) {
+                std::uniform_int_distribution<std::size_t> pick(0, stubs.size() - 1);
+                const std::size_t i = pick(rng);
+                const std::size_t j = pick(rng);
+                const int a = stubs[i];
+                const int b = stubs[j];
+                if (a == b || edges.contains(key(a, b))) {
+                    continue;
+                }
+                const auto resource = static_cast<int>(edges.size());
+                edges.insert(key(a, b));
+                memberships.emplace_back(resource, a);
+                memberships.emplace_back(resource, b);
+                // Remove both stubs by swapping them to the back, higher index first
+                for (const std::size_t index : {std::max(i, j), std::min(i, j)}) {
+                    stubs[index] = stubs.back();
+                    stubs.pop_back();
+                }
+                stuck = false;
+                break;
+            }
+        }
+        if (!stuck) {
+            return fromMemberships(numWorkers, static_cast<int>(edges.size()), std::move(memberships));
+        }
+    }
+    throw std::invalid_argument("could not draw a random " + std::to_string(degree) + "-regular graph of " +
+                                std::to_string(numWorkers) + " workers");
+}
+
+ResourceGraph ResourceGraph::fromFile(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        throw std::runtime_error("cannot open topology file '" + path + "': " + std::strerror(errno));
+    }
+    std::vector<std::pair<int, int>> memberships;
+    int numResources = 0;
+    int numWorkers = 0;
+    std::string line;
+    for (int lineNumber = 1; std::getline(in, line); lineNumber++) {
+        const std::size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#') {
+            continue;
+        }
+        std::istringstream fields(line);
+        long long worker = 0;
+        bool any = false;
+        while (fields >> worker) {
+            if (worker < 0 || worker >= 100'000'000) {
+                throw std::invalid_argument(path + ":" + std::to_string(lineNumber) + ": invalid worker ID " +
+                                            std::to_string(worker));
+            }
+            memberships.emplace_back(numResources, static_cast<int>(worker));
+            numWorkers = std::max(numWorkers, static_cast<int>(worker) + 1);
+            any = true;
+        }
+        if (!fields.eof() || !any) {
+            throw std::invalid_argument(path + ":" + std::to_string(lineNumber) + ": expected worker IDs");
+        }
+        numResources++;
+    }
+    if (numWorkers == 0) {
+        throw std::invalid_argument("topology file '" + path + "' lists no resources");
+    }
+    return fromMemberships(numWorkers, numResources, std::move(memberships));
+}
+
+int ResourceGraph::maxResourcesPerWorker() const {
+    int most = 0;
+    for (std::size_t w = 0; w + 1 < offsets_.size(); w++) {
+        most = std::max(most, offsets_[w + 1] - offsets_[w]);
+    }
+    return most;
+}
+
+int ResourceGraph::maxWorkersPerResource() const {
+    std::vector<int> sharers(static_cast<std::size_t>(numResources_), 0);
+    for (const int resource : resources_) {
+        sharers[resource]++;
+    }
+    return sharers.empty() ? 0 : *std::max_element(sharers.begin(), sharers.end());
+}
+
+ResourceGraph ResourceGraph::fromMemberships(const int numWorkers, const int numResources,
+                                             std::vector<std::pair<int, int>> memberships) {
+    // Sorting by (worker, resource) lays out the rows in order; the duplicates end up adjacent
+    std::sort(memberships.begin(), memberships.end(), [](const auto& a, const auto& b) {
+        return std::pair(a.second, a.first) < std::pair(b.second, b.first);
+    });
+    memberships.erase(std::unique(memberships.begin(), memberships.end()), memberships.end());
+
+    ResourceGraph graph;
+    graph.numResources_ = numResources;
+    graph.offsets_.assign(static_cast<std::size_t>(numWorkers) + 1, 0);
+    graph.resources_.reserve(memberships.size());
+    for (const auto& [resource, worker] : memberships) {
+        graph.offsets_[worker + 1]++;
+        graph.resources_.push_back(resource);
+    }
+    for (int w = 0; w < numWorkers; w++) {
+        graph.offsets_[w + 1] += graph.offsets_[w];
+    }
+    return graph;
+}
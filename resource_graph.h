@@ -0,0 +1,95 @@
+/*
+    ResourceGraph
+    -------------
+    Which workers share which resources, generalizing the ring of philosophers and chopsticks.
+
+    Every resource is shared by the workers listed for it, and every worker needs all of its
+    resources at once. The graph is stored in compressed sparse row (CSR) form: the resource
+    IDs of worker w are resources[offsets[w]] .. resources[offsets[w + 1] - 1], sorted
+    ascending. Taking them in that order is the global resource ordering of the hierarchy
+    strategy, so no wait-for cycle can form on any graph.
+
+    Topologies (--topology=SPEC):
+    - ring          N workers in a ring, worker i sharing resource i with worker i - 1 and
+                    resource i + 1 with worker i + 1: the dining philosophers.
+    - grid:RxC      R x C workers on a torus, one resource on each edge between neighbours,
+                    four per worker (shards with locks on their borders).
+    - random:K      random K-regular graph of N workers, one resource per edge, so every
+                    worker needs K resources.
+    - file:PATH     one resource per line, given as the IDs of the workers sharing it
+                    ("3 17" for an edge, more IDs for a resource shared by several workers);
+                    blank lines and lines starting with '#' are skipped.
+    N is the number of philosophers.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+struct TopologySpec {
+    enum class Kind {
+        Ring,
+        Grid,
+        Random,
+        File
+    };
+
+    Kind kind = Kind::Ring;
+    int rows = 0;      // Grid
+    int columns = 0;   // Grid
+    int degree = 0;    // Random
+    std::string path;  // File
+
+    /*
+        Function: parse
+        ---------------
+        Parses a spec as described above. Throws std::invalid_argument when malformed.
+    */
+    static TopologySpec parse(const std::string& spec);
+
+    // Canonical spec, e.g. "grid:32x32"
+    std::string describe() const;
+};
+
+class ResourceGraph {
+public:
+    /*
+        Function: build
+        ---------------
+        Builds the topology of the spec, with numWorkers workers for the ring and the random
+        graph and seed drawing the random graph. Throws std::invalid_argument for impossible
+        parameters or a malformed file, and std::runtime_error if the file cannot be read.
+    */
+    static ResourceGraph build(const TopologySpec& spec, int numWorkers, std::uint64_t seed);
+
+    static ResourceGraph ring(int numWorkers);
+    static ResourceGraph grid(int rows, int columns);
+    static ResourceGraph randomRegular(int numWorkers, int degree, std::uint64_t seed);
+    static ResourceGraph fromFile(const std::string& path);
+
+    int numWorkers() const { return static_cast<int>(offsets_.size()) - 1; }
+    int numResources() const { return numResources_; }
+
+    // Resources worker w needs, in acquisition order
+    std::span<const int> resourcesOf(const int worker) const {
+        return {resources_.data() + offsets_[worker], resources_.data() + offsets_[worker + 1]};
+    }
+
+    // Most resources any worker needs
+    int maxResourcesPerWorker() const;
+
+    // Most workers sharing one resource
+    int maxWorkersPerResource() const;
+
+private:
+    // Builds the CSR arrays from (resource, worker) memberships; duplicates are dropped
+    static ResourceGraph fromMemberships(int numWorkers, int numResources, std::vector<std::pair<int, int>> memberships);
+
+    int numResources_ = 0;
+    std::vector<int> offsets_{0};
+    std::vector<int> resources_;
+};
@@ -0,0 +1,59 @@
+/*
+    SpscRing
+    --------
+    Bounded single-producer / single-consumer ring buffer.
+
+    Exactly one thread may call tryPush() and exactly one (other) thread may call tryPop().
+    The head and tail indices live on separate cache lines, and each side keeps a cached copy
+    of the opposite index so the common case touches no shared line written by the other side.
+*/
+
+#pragma once
+
+#include "cache_line.h"
+
+#include <atomic>
+#include <cstddef>
+
+template <typename T, std::size_t Capacity>
+class SpscRing {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    bool tryPush(const T& value) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cachedHead_ == Capacity) {
+            cachedHead_ = head_.load(std::memory_order_acquire);
+            if (tail - cachedHead_ == Capacity) {
+                return false;  // Full
+            }
+        }
+        buffer_[tail & (Capacity - 1)] = value;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPop(T& value) {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cachedTail_) {
+            cachedTail_ = tail_.load(std::memory_order_acquire);
+            if (head == cachedTail_) {
+                return false;  // Empty
+            }
+        }
+        value = buffer_[head & (Capacity - 1)];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    // Producer side
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> tail_{0};
+    std::size_t cachedHead_ = 0;
+
+    // Consumer side
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> head_{0};
+    std::size_t cachedTail_ = 0;
+
+    alignas(CACHE_LINE_SIZE) T buffer_[Capacity];
+};
@@ -0,0 +1,106 @@
+/*
+    StaticTable
+    -----------
+    A chopstick table specialized at compile time for one table size N, one ordering
+    strategy (asymmetric or hierarchy) and one chopstick primitive, selected at startup for
+    the common sizes (see specializedTable() in philosopher.cpp), with the NumaArray-backed
+    strategies of makeStrategy() as the fallback for every other combination.
+
+    Compared with the dynamic strategies:
+    - the right neighbour (id + 1) % N is a mask for power-of-two N and one compare
+      otherwise, and the pickup order is decided by constant expressions,
+    - the chopsticks are a static array per instantiation, so their addresses are link-time
+      constants instead of loads through the strategy object,
+    - the class is final, so a philosopher loop instantiated on it calls acquire() and
+      release() directly and can inline them, without the virtual call per meal.
+
+    The array being static, only one StaticTable per instantiation may exist at a time:
+    create() returns nullptr while another one is alive. Every run leaves all chopsticks
+    free (a stopped acquire() puts back what it picked up), so the next table of the same
+    size starts from a clean array. No NUMA placement: the array is wherever the loader put it.
+*/
+
+#pragma once
+
+#include "chopstick.h"
+#include "strategy.h"
+
+#include <atomic>
+#include <memory>
+#include <stop_token>
+
+template <int N, StrategyKind Kind, typename Chopstick>
+class StaticTable final : public AcquisitionStrategy {
+    static_assert(N >= 2, "a table needs at least two chopsticks");
+    static_assert(Kind == StrategyKind::Asymmetric || Kind == StrategyKind::Hierarchy,
+                  "only the ordering strategies have a static table");
+
+public:
+    // The table, or nullptr while another table of this instantiation is in use
+    static std::unique_ptr<StaticTable> create() {
+        if (inUse_.exchange(true, std::memory_order_acquire)) {
+            return nullptr;
+        }
+        return std::unique_ptr<StaticTable>(new StaticTable());
+    }
+
+    ~StaticTable() override { inUse_.store(false, std::memory_order_release); }
+
+    StaticTable(const StaticTable&) = delete;
+    StaticTable& operator=(const StaticTable&) = delete;
+
+    // Right chopstick of seat i, without a division
+    static constexpr int rightOf(const int i) {
+        if constexpr ((N & (N - 1)) == 0) {
+            return (i + 1) & (N - 1);
+        } else {
+            return i + 1 == N ? 0 : i + 1;
+        }
+    }
+
+    bool acquire(const Seat& seat, const std::stop_token& stop) override {
+        const int left = seat.id;
+        const int right = rightOf(seat.id);
+        bool rightFirst;
+        if constexpr (Kind == StrategyKind::Asymmetric) {
+            rightFirst = seat.id % 2 == 0;
+        } else {
+            rightFirst = right < left;  // Lower-numbered first: only the last seat wraps around
+        }
+        const int first = rightFirst ? right : left;
+        const int second = rightFirst ? left : right;
+
+        if (!acquireOne(seat, first, stop)) {
+            return false;
+        }
+        if (!acquireOne(seat, second, stop)) {
+            chopsticks_[first].release();
+            return false;
+        }
+        return true;
+    }
+
+    void release(const Seat& seat) override {
+        chopsticks_[seat.id].release();
+        chopsticks_[rightOf(seat.id)].release();
+    }
+
+private:
+    StaticTable() = default;
+
+    // Same accounting as the dynamic strategies: a failed try is counted, then it blocks
+    static bool acquireOne(const Seat& seat, const int chopstick, const std::stop_token& stop) {
+        if (!chopsticks_[chopstick].tryAcquire()) {
+            noteFailedTryAcquire(seat, chopstick);
+            noteBlockedOn(seat, chopstick);
+            if (!chopsticks_[chopstick].acquire(stop)) {
+                return false;
+            }
+        }
+        notePickedUp(seat, chopstick);
+        return true;
+    }
+
+    static inline Chopstick chopsticks_[N];
+    static inline std::atomic<bool> inUse_{false};
+};
@@ -0,0 +1,91 @@
+#include "stats_reporter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <numeric>
+#include <vector>
+
+namespace {
+
+constexpr int MAX_ROWS = 64;  // Larger tables only list the philosophers that waited longest
+
+volatile std::sig_atomic_t snapshotRequested = 0;
+
+extern "C" void onSnapshotSignal(int) {
+    snapshotRequested = 1;
+}
+
+double toMs(const std::uint64_t ns) {
+    return static_cast<double>(ns) / 1e6;
+}
+
+void printRow(std::FILE* out, const char* label, const StatsSnapshot& row) {
+    const double avgWaitUs = row.meals == 0 ? 0.0 : static_cast<double>(row.hungryNs) / 1e3 / static_cast<double>(row.meals);
+    std::fprintf(out, "%-8s %12llu %14.1f %12.2f %14.1f %12llu %12.1f\n", label,
+                 static_cast<unsigned long long>(row.meals), toMs(row.hungryNs), avgWaitUs, toMs(row.halfHeldNs),
+                 static_cast<unsigned long long>(row.failedTryAcquires), static_cast<double>(row.maxWaitNs) / 1e3);
+}
+
+}  // namespace
+
+StatsReporter::StatsReporter(const DiningTable& table, const int intervalMs)
+    : table_(table), intervalMs_(intervalMs), previousHandler_(std::signal(SIGUSR1, onSnapshotSignal)) {
+    thread_ = std::thread(&StatsReporter::run, this);
+}
+
+StatsReporter::~StatsReporter() {
+    stop_.store(true, std::memory_order_relaxed);
+    thread_.join();
+    std::signal(SIGUSR1, previousHandler_);
+}
+
+void StatsReporter::printSnapshot(std::FILE* out) const {
+    std::vector<StatsSnapshot> rows(table_.numPhilosophers);
+    StatsSnapshot total;
+    for (int i = 0; i < table_.numPhilosophers; i++) {
+        rows[i].add(table_.stats[i]);
+        total.add(table_.stats[i]);
+    }
+
+    std::vector<int> order(table_.numPhilosophers);
+    std::iota(order.begin(), order.end(), 0);
+    if (table_.numPhilosophers > MAX_ROWS) {
+        std::partial_sort(order.begin(), order.begin() + MAX_ROWS, order.end(),
+                          [&](const int a, const int b) { return rows[a].hungryNs > rows[b].hungryNs; });
+        order.resize(MAX_ROWS);
+    }
+
+    std::fprintf(out, "%-8s %12s %14s %12s %14s %12s %12s\n", "seat", "meals", "hungry ms", "avg wait us",
+                 "half-held ms", "failed tries", "max wait us");
+    for (const int id : order) {
+        printRow(out, std::to_string(id).c_str(), rows[id]);
+    }
+    if (table_.numPhilosophers > MAX_ROWS) {
+        std::fprintf(out, "(%d seats with the longest hungry time of %d shown)\n", MAX_ROWS, table_.numPhilosophers);
+    }
+    printRow(out, "total", total);
+    std::fflush(out);
+}
+
+void StatsReporter::run() {
+    constexpr auto POLL = std::chrono::milliseconds(50);
+    auto nextReport = std::chrono::steady_clock::now() + std::chrono::milliseconds(intervalMs_);
+
+    while (!stop_.load(std::memory_order_relaxed)) {
+        std::this_thread::sleep_for(POLL);
+
+        bool report = false;
+        if (snapshotRequested != 0) {
+            snapshotRequested = 0;
+            report = true;
+        }
+        if (intervalMs_ > 0 && std::chrono::steady_clock::now() >= nextReport) {
+            nextReport += std::chrono::milliseconds(intervalMs_);
+            report = true;
+        }
+        if (report) {
+            printSnapshot(stderr);
+        }
+    }
+}
@@ -0,0 +1,39 @@
+/*
+    StatsReporter
+    -------------
+    Background reader of the per-philosopher counters. It never pauses or synchronizes with
+    the philosophers: every counter is a relaxed atomic written only by its owner, so a
+    snapshot is a plain walk over the counter blocks.
+
+    A live table is printed to stderr every intervalMs milliseconds (if non-zero) and whenever
+    the process receives SIGUSR1.
+*/
+
+#pragma once
+
+#include "philosopher.h"
+
+#include <atomic>
+#include <cstdio>
+#include <thread>
+
+class StatsReporter {
+public:
+    StatsReporter(const DiningTable& table, int intervalMs);
+    ~StatsReporter();
+
+    StatsReporter(const StatsReporter&) = delete;
+    StatsReporter& operator=(const StatsReporter&) = delete;
+
+    // Prints one snapshot of the counters
+    void printSnapshot(std::FILE* out) const;
+
+private:
+    void run();
+
+    const DiningTable& table_;
+    const int intervalMs_;
+    void (*previousHandler_)(int);  // SIGUSR1 handler before this reporter, restored on destruction
+    std::atomic<bool> stop_{false};
+    std::thread thread_;
+};
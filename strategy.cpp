@@ -0,0 +1,759 @@
+#include "strategy.h"
+#include "cpu_relax.h"
+#include "duration.h"
+#include "fork_bitmap.h"
+#include "logger.h"
+#include "mpmc_queue.h"
+#include "numa_array.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <memory>
+#include <semaphore>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+void notePickedUp(const Seat& seat, const int chopstick) {
+    logEvent(seat.id, chopstick == seat.left ? Event::PickedLeft : Event::PickedRight, chopstick);
+    if (seat.stats != nullptr && seat.stats->chopsticksHeld++ == 0) {
+        seat.stats->firstPickedUp = std::chrono::steady_clock::now();
+    }
+}
+
+void noteFailedTryAcquire(const Seat& seat, const int chopstick) {
+    if (seat.stats != nullptr) {
+        bump(seat.stats->failedTryAcquires);
+        if (chopstick == seat.right && chopstick != seat.left) {
+            bump(seat.stats->failedRightTryAcquires);
+        }
+    }
+}
+
+void noteBlockedOn(const Seat& seat, const int chopstick) {
+    if (seat.stats == nullptr) {
+        return;
+    }
+    const int other = chopstick == seat.left ? seat.right : seat.left;
+    const WaitState state{seat.stats->chopsticksHeld > 0 ? other : -1, chopstick};
+    seat.stats->waitState.store(state.pack(), std::memory_order_relaxed);
+    seat.stats->waitPublished = true;
+}
+
+namespace {
+
+/*
+    Class: ChopstickTableStrategy
+    -----------------------------
+    Base of the strategies that work on a table of Chopstick primitives, one per seat, each
+    allocated on the NUMA node of its seat.
+*/
+template <typename Chopstick>
+class ChopstickTableStrategy : public AcquisitionStrategy {
+public:
+    ChopstickTableStrategy(const int numPhilosophers, const std::function<int(int)>& chopstickNode)
+        : chopsticks_(numPhilosophers, chopstickNode) {}
+
+    void release(const Seat& seat) override {
+        chopsticks_[seat.left].release();
+        chopsticks_[seat.right].release();
+    }
+
+protected:
+    // Picks up both chopsticks in the given order
+    bool acquireInOrder(const Seat& seat, const int first, const int second, const std::stop_token& stop) {
+        if (!acquireOne(seat, first, stop)) {
+            return false;
+        }
+        if (!acquireOne(seat, second, stop)) {
+            chopsticks_[first].release();
+            return false;
+        }
+        return true;
+    }
+
+    // Tries the chopstick first so that contended pickups are counted, then blocks
+    bool acquireOne(const Seat& seat, const int chopstick, const std::stop_token& stop) {
+        if (!chopsticks_[chopstick].tryAcquire()) {
+            noteFailedTryAcquire(seat, chopstick);
+            noteBlockedOn(seat, chopstick);
+            if (!chopsticks_[chopstick].acquire(stop)) {
+                return false;
+            }
+        }
+        notePickedUp(seat, chopstick);
+        return true;
+    }
+
+    NumaArray<Chopstick> chopsticks_;
+};
+
+/*
+    Class: AsymmetricStrategy
+    -------------------------
+    Even-numbered philosophers pick up the right chopstick first, odd-numbered philosophers
+    the left one, so not all philosophers can wait for chopsticks in a circular pattern.
+*/
+template <typename Chopstick>
+class AsymmetricStrategy final : public ChopstickTableStrategy<Chopstick> {
+public:
+    using ChopstickTableStrategy<Chopstick>::ChopstickTableStrategy;
+
+    bool acquire(const Seat& seat, const std::stop_token& stop) override {
+        if (seat.id % 2 == 0) {
+            return this->acquireInOrder(seat, seat.right, seat.left, stop);
+        }
+        return this->acquireInOrder(seat, seat.left, seat.right, stop);
+    }
+};
+
+/*
+    Class: HierarchyStrategy
+    ------------------------
+    Chopsticks are totally ordered by index and every philosopher picks up the lower-numbered
+    one first. A wait-for cycle would need some philosopher to wait for a lower chopstick
+    while holding a higher one, which never happens.
+*/
+template <typename Chopstick>
+class HierarchyStrategy final : public ChopstickTableStrategy<Chopstick> {
+public:
+    using ChopstickTableStrategy<Chopstick>::ChopstickTableStrategy;
+
+    bool acquire(const Seat& seat, const std::stop_token& stop) override {
+        return this->acquireInOrder(seat, std::min(seat.left, seat.right), std::max(seat.left, seat.right), stop);
+    }
+};
+
+/*
+    Class: NaiveStrategy
+    --------------------
+    Left chopstick first, then the right one, with nothing to break the symmetry: when every
+    philosopher holds its left chopstick, all of them wait for their right one forever.
+*/
+template <typename Chopstick>
+class NaiveStrategy final : public ChopstickTableStrategy<Chopstick> {
+public:
+    using ChopstickTableStrategy<Chopstick>::ChopstickTableStrategy;
+
+    bool acquire(const Seat& seat, const std::stop_token& stop) override {
+        return this->acquireInOrder(seat, seat.left, seat.right, stop);
+    }
+};
+
+/*
+    Class: BackoffStrategy
+    ----------------------
+    Breaks hold-and-wait instead of the wait-for cycle: the first chopstick (asymmetric
+    order) is waited for, the second only for policy.tryFor. When that fails, the first goes
+    back on the table, so the neighbour waiting for it can eat, and the philosopher sleeps
+    for a delay drawn uniformly up to a ceiling that starts at policy.minDelay and doubles
+    with every failure of the acquisition, up to policy.maxDelay. The randomness keeps two
+    neighbours from retrying in lockstep.
+*/
+template <typename Chopstick>
+class BackoffStrategy final : public ChopstickTableStrategy<Chopstick> {
+public:
+    BackoffStrategy(const int numPhilosophers, const std::function<int(int)>& chopstickNode,
+                    const BackoffPolicy& policy, const std::uint64_t seed)
+        : ChopstickTableStrategy<Chopstick>(numPhilosophers, chopstickNode), policy_(policy), random_(numPhilosophers) {
+        // Scrambled, as consecutive SplitMix64 states would make the streams of adjacent
+        // seeds the same but one delay apart
+        for (int i = 0; i < numPhilosophers; i++) {
+            random_[i].state = mix(seed * 0x9e3779b97f4a7c15ULL + static_cast<std::uint64_t>(i));
+        }
+    }
+
+    bool acquire(const Seat& seat, const std::stop_token& stop) override {
+        const int first = seat.id % 2 == 0 ? seat.right : seat.left;
+        const int second = seat.id % 2 == 0 ? seat.left : seat.right;
+        auto ceiling = policy_.minDelay;
+        while (true) {
+            if (!this->acquireOne(seat, first, stop)) {
+                return false;
+            }
+            Chopstick& other = this->chopsticks_[second];
+            if (other.tryAcquire()) {
+                notePickedUp(seat, second);
+                return true;
+            }
+            noteFailedTryAcquire(seat, second);
+            if (other.tryAcquireFor(policy_.tryFor)) {
+                notePickedUp(seat, second);
+                return true;
+            }
+
+            logEvent(seat.id, Event::PutDown);  // Before the neighbour can pick it up
+            this->chopsticks_[first].release();
+            if (seat.stats != nullptr) {
+                // The hold of an attempt given up on is hold-and-wait time all the same
+                const auto held = std::chrono::steady_clock::now() - seat.stats->firstPickedUp;
+                bump(seat.stats->halfHeldNs,
+                     static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(held).count()));
+                seat.stats->chopsticksHeld = 0;
+                seat.stats->waitState.store(0, std::memory_order_relaxed);  // Not blocked while backing off
+                seat.stats->waitPublished = false;
+                bump(seat.stats->backoffs);
+            }
+            sleepFor(delay(seat.id, ceiling), stop);
+            if (stop.stop_requested()) {
+                return false;
+            }
+            ceiling = std::min(ceiling * 2, policy_.maxDelay);
+        }
+    }
+
+private:
+    struct alignas(CACHE_LINE_SIZE) SeatRandom {
+        std::uint64_t state = 0;
+    };
+
+    // SplitMix64 output function
+    static std::uint64_t mix(std::uint64_t z) {
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    // Uniform in [0, ceiling], from the seat's SplitMix64 stream
+    std::chrono::nanoseconds delay(const int seat, const std::chrono::nanoseconds ceiling) {
+        const std::uint64_t z = mix(random_[seat].state += 0x9e3779b97f4a7c15ULL);
+        return std::chrono::nanoseconds(static_cast<std::int64_t>(z % (static_cast<std::uint64_t>(ceiling.count()) + 1)));
+    }
+
+    const BackoffPolicy policy_;
+    std::vector<SeatRandom> random_;  // Written only by the seat's philosopher
+};
+
+/*
+    Class: WaiterStrategy
+    ---------------------
+    A waiter (counting semaphore) admits at most N-1 philosophers to the table at once.
+    With one seat always empty, at least one admitted philosopher can get both chopsticks,
+    so the plain left-then-right order cannot deadlock.
+*/
+template <typename Chopstick>
+class WaiterStrategy final : public ChopstickTableStrategy<Chopstick> {
+public:
+    WaiterStrategy(const int numPhilosophers, const std::function<int(int)>& chopstickNode)
+        : ChopstickTableStrategy<Chopstick>(numPhilosophers, chopstickNode), admissions_(numPhilosophers - 1) {}
+
+    bool acquire(const Seat& seat, const std::stop_token& stop) override {
+        if (!acquireUnlessStopped(admissions_, stop)) {
+            return false;
+        }
+        if (!this->acquireInOrder(seat, seat.left, seat.right, stop)) {
+            admissions_.release();
+            return false;
+        }
+        return true;
+    }
+
+    void release(const Seat& seat) override {
+        ChopstickTableStrategy<Chopstick>::release(seat);
+        admissions_.release();
+    }
+
+private:
+    std::counting_semaphore<> admissions_;
+};
+
+/*
+    Class: ChandyMisraStrategy
+    --------------------------
+    Every fork is owned by one of its two philosophers and is either clean or dirty.
+    - Initially each fork is dirty and owned by the lower-numbered of its two philosophers.
+    - A hungry philosopher requests a missing fork by recording itself as the fork's
+      requester and waiting on the fork's condition variable. The request is granted as
+      soon as the fork is dirty and its owner is not eating; the fork is cleaned when it
+      changes hands.
+    - A clean fork is never given up, so a philosopher that received a fork keeps it until
+      it has eaten. Eating makes both forks dirty and wakes any pending requester.
+    - An owner that becomes hungry again before a pending requester took its dirty fork
+      hands the fork over clean and requests it back, so it cannot eat twice on a dirty fork
+      while its neighbour waits.
+    Handing forks over only from dirty (has eaten) to hungry keeps the precedence graph
+    acyclic, which makes the protocol deadlock- and starvation-free.
+*/
+class ChandyMisraStrategy final : public AcquisitionStrategy {
+public:
+    explicit ChandyMisraStrategy(const int numPhilosophers) : forks_(numPhilosophers) {
+        // Fork i lies between philosophers i - 1 and i; fork 0 between N - 1 and 0
+        for (int i = 0; i < numPhilosophers; i++) {
+            forks_[i].owner = i == 0 ? 0 : i - 1;
+        }
+    }
+
+    bool acquire(const Seat& seat, const std::stop_token& stop) override {
+        Fork& left = forks_[seat.left];
+        Fork& right = forks_[seat.right];
+
+        while (true) {
+            // Owning a fork without eating holds nothing back, so giving up needs no cleanup
+            if (!request(seat.id, left, stop) || !request(seat.id, right, stop)) {
+                return false;
+            }
+
+            // A neighbour may have claimed back a dirty fork while we waited for the other one
+            std::scoped_lock lock(left.mutex, right.mutex);
+            if (left.owner == seat.id && right.owner == seat.id) {
+                left.inUse = true;
+                right.inUse = true;
+                break;
+            }
+        }
+
+        notePickedUp(seat, seat.left);
+        notePickedUp(seat, seat.right);
+        return true;
+    }
+
+    void release(const Seat& seat) override {
+        for (const int index : {seat.left, seat.right}) {
+            Fork& fork = forks_[index];
+            {
+                std::lock_guard<std::mutex> lock(fork.mutex);
+                fork.dirty = true;
+                fork.inUse = false;
+            }
+            fork.changed.notify_all();
+        }
+    }
+
+private:
+    struct alignas(CACHE_LINE_SIZE) Fork {
+        std::mutex mutex;
+        std::condition_variable_any changed;
+        int owner = 0;
+        bool dirty = true;   // Dirty forks are yielded on request
+        bool inUse = false;  // Set while the owner is eating
+        int requester = -1;  // Hungry neighbour waiting for this fork
+    };
+
+    // Waits until the philosopher owns the fork; false if a stop was requested first
+    static bool request(const int philosopherID, Fork& fork, const std::stop_token& stop) {
+        std::unique_lock<std::mutex> lock(fork.mutex);
+        if (fork.owner == philosopherID) {
+            if (!fork.dirty || fork.requester == -1) {
+                return true;
+            }
+            // The neighbour asked first: it gets the fork clean, and we ask for it back
+            fork.owner = fork.requester;
+            fork.dirty = false;
+            fork.changed.notify_all();
+        }
+
+        fork.requester = philosopherID;
+        const bool granted = fork.changed.wait(lock, stop, [&] {
+            return fork.owner == philosopherID || (fork.dirty && !fork.inUse);
+        });
+        if (fork.requester == philosopherID) {
+            fork.requester = -1;
+        }
+        if (!granted) {
+            return false;
+        }
+        if (fork.owner != philosopherID) {
+            fork.owner = philosopherID;
+            fork.dirty = false;
+        }
+        return true;
+    }
+
+    std::vector<Fork> forks_;
+};
+
+/*
+    Class: CasBitmapStrategy
+    ------------------------
+    Takes both forks in one compare-and-swap on the packed fork bitmap, so a philosopher never
+    sits holding half a meal.
+*/
+class CasBitmapStrategy final : public AcquisitionStrategy {
+public:
+    explicit CasBitmapStrategy(const int numPhilosophers) : forks_(numPhilosophers) {}
+
+    bool acquire(const Seat& seat, const std::stop_token& stop) override {
+        if (!forks_.acquirePair(seat.left, seat.right, stop)) {
+            return false;
+        }
+        notePickedUp(seat, seat.left);
+        notePickedUp(seat, seat.right);
+        return true;
+    }
+
+    void release(const Seat& seat) override {
+        forks_.releasePair(seat.left, seat.right);
+    }
+
+private:
+    ForkBitmap forks_;
+};
+
+/*
+    Class: ArbiterStrategy
+    ----------------------
+    A central arbiter thread owns the state of every fork. A hungry philosopher pushes a
+    request onto the MPMC queue and waits on its own grant slot; a release is a message on
+    the same queue, so putting the forks down never waits for the arbiter.
+
+    The arbiter drains up to ARBITER_BATCH messages, applies them, and then makes one pass
+    over the waiting requests in arrival order, granting every pair whose forks are free and
+    publishing the grants. The pass is starvation-free: the forks of a waiting request are
+    reserved for it for the rest of the pass, so a younger request cannot take one of them
+    while the older one waits for the other. When the queue is empty the arbiter spins
+    briefly, then parks on an event count that producers only touch while it sleeps.
+*/
+class ArbiterStrategy final : public AcquisitionStrategy {
+public:
+    explicit ArbiterStrategy(const int numPhilosophers)
+        : numPhilosophers_(numPhilosophers),
+          queue_(2 * static_cast<std::size_t>(numPhilosophers)),  // A request and a cancel per seat
+          slots_(numPhilosophers),
+          busy_(numPhilosophers, 0),
+          reserved_(numPhilosophers, 0),
+          holding_(numPhilosophers, 0),
+          started_(std::chrono::steady_clock::now()) {
+        thread_ = std::jthread([this](const std::stop_token stop) { run(stop); });
+    }
+
+    bool acquire(const Seat& seat, const std::stop_token& stop) override {
+        Slot& slot = slots_[seat.id];
+        slot.state.store(WAITING, std::memory_order_relaxed);
+        send(seat.id, Message::Request);
+        if (!awaitGrant(slot, stop)) {
+            send(seat.id, Message::Leave);  // Withdraws the request, or returns a late grant
+            return false;
+        }
+        notePickedUp(seat, seat.left);
+        notePickedUp(seat, seat.right);
+        return true;
+    }
+
+    void release(const Seat& seat) override {
+        send(seat.id, Message::Leave);
+    }
+
+    std::optional<ArbiterStats> arbiterStats() const override {
+        ArbiterStats stats;
+        stats.messages = load(Stat::Messages);
+        stats.grants = load(Stat::Grants);
+        stats.batches = load(Stat::Batches);
+        stats.maxBatch = load(Stat::MaxBatch);
+        stats.maxPending = load(Stat::MaxPending);
+        stats.parks = load(Stat::Parks);
+        stats.busy = std::chrono::nanoseconds(load(Stat::BusyNs));
+        stats.lifetime = std::chrono::steady_clock::now() - started_;
+        return stats;
+    }
+
+private:
+    static constexpr std::size_t ARBITER_BATCH = 256;  // Messages served per grant pass, at most
+    static constexpr int MAX_SPIN = 64;                // cpuRelax() hints in the last spin round
+
+    // Grant slot states
+    static constexpr std::uint32_t WAITING = 0;
+    static constexpr std::uint32_t GRANTED = 1;
+    static constexpr std::uint32_t WAKE = 2;  // A stop was requested while waiting
+
+    enum class Message : std::uint32_t {
+        Request,
+        Leave  // Puts down the forks if granted, withdraws the request otherwise
+    };
+
+    enum class Stat {
+        Messages,
+        Grants,
+        Batches,
+        MaxBatch,
+        MaxPending,
+        Parks,
+        BusyNs,
+        Count
+    };
+
+    struct alignas(CACHE_LINE_SIZE) Slot {
+        std::atomic<std::uint32_t> state{WAITING};
+    };
+
+    std::uint64_t load(const Stat stat) const {
+        return counters_[static_cast<int>(stat)].load(std::memory_order_relaxed);
+    }
+
+    // Written by the arbiter thread only
+    void add(const Stat stat, const std::uint64_t amount) { bump(counters_[static_cast<int>(stat)], amount); }
+    void raise(const Stat stat, const std::uint64_t value) { raiseMax(counters_[static_cast<int>(stat)], value); }
+
+    void send(const int seat, const Message message) {
+        const std::uint32_t word = static_cast<std::uint32_t>(seat) << 1 | static_cast<std::uint32_t>(message);
+        while (!queue_.tryPush(word)) {
+            std::this_thread::yield();  // Only with more than two messages per seat in flight
+        }
+        // Pairs with the arbiter's fence between announcing its sleep and re-checking the queue
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleeping_.load(std::memory_order_relaxed)) {
+            signal_.fetch_add(1, std::memory_order_relaxed);
+            signal_.notify_one();
+        }
+    }
+
+    static bool awaitGrant(Slot& slot, const std::stop_token& stop) {
+        for (int backoff = 1; backoff <= MAX_SPIN; backoff *= 2) {
+            if (slot.state.load(std::memory_order_acquire) == GRANTED) {
+                return true;
+            }
+            for (int i = 0; i < backoff; i++) {
+                cpuRelax();
+            }
+        }
+        std::stop_callback wakeOnStop(stop, [&slot] {
+            std::uint32_t expected = WAITING;
+            if (slot.state.compare_exchange_strong(expected, WAKE, std::memory_order_relaxed)) {
+                slot.state.notify_all();
+            }
+        });
+        while (true) {
+            const std::uint32_t state = slot.state.load(std::memory_order_acquire);
+            if (state == GRANTED) {
+                return true;
+            }
+            if (state == WAKE) {
+                return false;
+            }
+            slot.state.wait(WAITING, std::memory_order_acquire);
+        }
+    }
+
+    void run(const std::stop_token& stop) {
+        std::stop_callback wakeOnStop(stop, [this] {
+            signal_.fetch_add(1, std::memory_order_relaxed);
+            signal_.notify_one();
+        });
+        while (!stop.stop_requested()) {
+            if (serveBatch()) {
+                continue;
+            }
+            bool served = false;
+            for (int backoff = 1; backoff <= MAX_SPIN && !served; backoff *= 2) {
+                for (int i = 0; i < backoff; i++) {
+                    cpuRelax();
+                }
+                served = serveBatch();
+            }
+            if (served) {
+                continue;
+            }
+
+            // Park. A producer that pushed before the fence is seen by the re-check; one that
+            // pushes after it sees the sleeping flag and bumps the signal.
+            const std::uint32_t seen = signal_.load(std::memory_order_relaxed);
+            sleeping_.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (!serveBatch() && !stop.stop_requested()) {
+                add(Stat::Parks, 1);
+                signal_.wait(seen, std::memory_order_relaxed);
+            }
+            sleeping_.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    // Serves up to ARBITER_BATCH messages and grants what it can. False if the queue was empty.
+    bool serveBatch() {
+        std::uint32_t word = 0;
+        if (!queue_.tryPop(word)) {
+            return false;
+        }
+        const auto start = std::chrono::steady_clock::now();
+        std::size_t served = 0;
+        do {
+            const int seat = static_cast<int>(word >> 1);
+            if (static_cast<Message>(word & 1) == Message::Request) {
+                pending_.push_back(seat);
+            } else {
+                leave(seat);
+            }
+        } while (++served < ARBITER_BATCH && queue_.tryPop(word));
+
+        grantPass();
+        for (const int seat : granted_) {
+            Slot& slot = slots_[seat];
+            slot.state.store(GRANTED, std::memory_order_release);
+            slot.state.notify_one();
+        }
+
+        add(Stat::Messages, served);
+        add(Stat::Grants, granted_.size());
+        add(Stat::Batches, 1);
+        raise(Stat::MaxBatch, served);
+        raise(Stat::MaxPending, pending_.size());
+        granted_.clear();
+        add(Stat::BusyNs, static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              std::chrono::steady_clock::now() - start).count()));
+        return true;
+    }
+
+    void leave(const int seat) {
+        if (holding_[seat] != 0) {
+            holding_[seat] = 0;
+            busy_[seat] = 0;
+            busy_[(seat + 1) % numPhilosophers_] = 0;
+            return;
+        }
+        // A withdrawn request, only when a stop cut the wait short
+        const auto request = std::find(pending_.begin(), pending_.end(), seat);
+        if (request != pending_.end()) {
+            pending_.erase(request);
+        }
+    }
+
+    void grantPass() {
+        const std::uint64_t pass = ++passes_;
+        std::size_t kept = 0;
+        for (const int seat : pending_) {
+            const int left = seat;
+            const int right = (seat + 1) % numPhilosophers_;
+            if (busy_[left] == 0 && busy_[right] == 0 && reserved_[left] != pass && reserved_[right] != pass) {
+                busy_[left] = 1;
+                busy_[right] = 1;
+                holding_[seat] = 1;
+                granted_.push_back(seat);
+            } else {
+                reserved_[left] = pass;
+                reserved_[right] = pass;
+                pending_[kept++] = seat;
+            }
+        }
+        pending_.resize(kept);
+    }
+
+    const int numPhilosophers_;
+    MpmcQueue<std::uint32_t> queue_;  // seat << 1 | Message
+    std::vector<Slot> slots_;         // Grant slot of every seat
+
+    // Arbiter thread state
+    std::vector<char> busy_;              // Fork i is taken
+    std::vector<std::uint64_t> reserved_;  // Grant pass in which fork i was reserved for an older request
+    std::vector<char> holding_;           // Seat i was granted its forks
+    std::vector<int> pending_;            // Waiting requests in arrival order
+    std::vector<int> granted_;            // Grants of the current batch
+    std::uint64_t passes_ = 0;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<bool> sleeping_{false};  // The arbiter is parked or about to be
+    alignas(CACHE_LINE_SIZE) std::atomic<std::uint32_t> signal_{0};  // Event count the arbiter parks on
+    alignas(CACHE_LINE_SIZE) std::atomic<std::uint64_t> counters_[static_cast<int>(Stat::Count)]{};
+    const std::chrono::steady_clock::time_point started_;
+    std::jthread thread_;  // Last: joined before the state above is destroyed
+};
+
+/*
+    Function: withChopstick
+    -----------------------
+    Instantiates a chopstick-table strategy for the selected primitive.
+*/
+template <template <typename> class Strategy>
+std::unique_ptr<AcquisitionStrategy> withChopstick(const ChopstickKind chopstick, const int numPhilosophers,
+                                                   const std::function<int(int)>& chopstickNode) {
+    switch (chopstick) {
+        case ChopstickKind::Semaphore:
+            return std::make_unique<Strategy<PaddedChopstick>>(numPhilosophers, chopstickNode);
+        case ChopstickKind::SpinPark:
+            return std::make_unique<Strategy<SpinParkChopstick>>(numPhilosophers, chopstickNode);
+        case ChopstickKind::Ticket:
+            return std::make_unique<Strategy<TicketChopstick>>(numPhilosophers, chopstickNode);
+    }
+    return nullptr;
+}
+
+}  // namespace
+
+std::unique_ptr<AcquisitionStrategy> makeStrategy(const StrategyKind kind, const ChopstickKind chopstick,
+                                                  const int numPhilosophers,
+                                                  const std::function<int(int)>& chopstickNode,
+                                                  const BackoffPolicy& backoff, const std::uint64_t seed) {
+    switch (kind) {
+        case StrategyKind::Asymmetric:
+            return withChopstick<AsymmetricStrategy>(chopstick, numPhilosophers, chopstickNode);
+        case StrategyKind::Hierarchy:
+            return withChopstick<HierarchyStrategy>(chopstick, numPhilosophers, chopstickNode);
+        case StrategyKind::Waiter:
+            return withChopstick<WaiterStrategy>(chopstick, numPhilosophers, chopstickNode);
+        case StrategyKind::ChandyMisra:
+            return std::make_unique<ChandyMisraStrategy>(numPhilosophers);
+        case StrategyKind::CasBitmap:
+            return std::make_unique<CasBitmapStrategy>(numPhilosophers);
+        case StrategyKind::Naive:
+            return withChopstick<NaiveStrategy>(chopstick, numPhilosophers, chopstickNode);
+        case StrategyKind::Arbiter:
+            return std::make_unique<ArbiterStrategy>(numPhilosophers);
+        case StrategyKind::Backoff:
+            switch (chopstick) {
+                case ChopstickKind::Semaphore:
+                    return std::make_unique<BackoffStrategy<PaddedChopstick>>(numPhilosophers, chopstickNode, backoff,
+                                                                                   seed);
+                case ChopstickKind::SpinPark:
+                    return std::make_unique<BackoffStrategy<SpinParkChopstick>>(numPhilosophers, chopstickNode, backoff,
+                                                                                   seed);
+                case ChopstickKind::Ticket:
+                    return std::make_unique<BackoffStrategy<TicketChopstick>>(numPhilosophers, chopstickNode, backoff,
+                                                                                   seed);
+            }
+            return nullptr;
+    }
+    return nullptr;
+}
+
+std::pair<int, int> pickUpOrder(const StrategyKind kind, const Seat& seat) {
+    switch (kind) {
+        case StrategyKind::Asymmetric:
+            return seat.id % 2 == 0 ? std::pair(seat.right, seat.left) : std::pair(seat.left, seat.right);
+        case StrategyKind::Hierarchy:
+            return {std::min(seat.left, seat.right), std::max(seat.left, seat.right)};
+        default:
+            return {seat.left, seat.right};
+    }
+}
+
+std::string strategyName(const StrategyKind kind) {
+    switch (kind) {
+        case StrategyKind::Asymmetric:
+            return "asymmetric";
+        case StrategyKind::Hierarchy:
+            return "hierarchy";
+        case StrategyKind::Waiter:
+            return "waiter";
+        case StrategyKind::ChandyMisra:
+            return "chandy-misra";
+        case StrategyKind::CasBitmap:
+            return "cas-bitmap";
+        case StrategyKind::Naive:
+            return "naive";
+        case StrategyKind::Backoff:
+            return "backoff";
+        case StrategyKind::Arbiter:
+            return "arbiter";
+    }
+    return "unknown";
+}
+
+BackoffPolicy BackoffPolicy::parse(const std::string& spec) {
+    const std::size_t first = spec.find(':');
+    const std::size_t second = first == std::string::npos ? std::string::npos : spec.find(':', first + 1);
+    if (second == std::string::npos || spec.find(':', second + 1) != std::string::npos) {
+        throw std::invalid_argument("invalid backoff spec '" + spec + "', expected TRY:MIN:MAX");
+    }
+    BackoffPolicy policy;
+    policy.tryFor = parseDuration(spec.substr(0, first));
+    policy.minDelay = parseDuration(spec.substr(first + 1, second - first - 1));
+    policy.maxDelay = parseDuration(spec.substr(second + 1));
+    if (policy.maxDelay < policy.minDelay) {
+        throw std::invalid_argument("backoff maximum is below its minimum in '" + spec + "'");
+    }
+    return policy;
+}
+
+std::string BackoffPolicy::describe() const {
+    return std::to_string(tryFor.count()) + "ns:" + std::to_string(minDelay.count()) + "ns:" +
+           std::to_string(maxDelay.count()) + "ns";
+}
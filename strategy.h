@@ -0,0 +1,158 @@
+/*
+    Strategy
+    --------
+    Pluggable chopstick acquisition strategies.
+
+    The philosopher loop only calls acquire() when hungry and release() after eating; the
+    strategy decides in which order, and under which protocol, the chopsticks are taken:
+    - Asymmetric:  even philosophers take the right chopstick first, odd ones the left
+                   (the original scheme).
+    - Hierarchy:   every philosopher takes the lower-numbered chopstick first (global
+                   resource ordering).
+    - Waiter:      a central arbiter semaphore lets at most N-1 philosophers reach for
+                   chopsticks at the same time.
+    - ChandyMisra: dirty/clean forks handed over on request (Chandy & Misra, 1984).
+    - CasBitmap:   both forks taken at once with a single CAS on a packed fork bitmap
+                   (see fork_bitmap.h).
+    - Naive:       everyone takes the left chopstick first. Deadlocks once all philosophers
+                   hold their left chopstick; a baseline for the deadlock detector.
+    - Backoff:     the asymmetric order, but the second chopstick is only tried for a
+                   bounded time; on failure the first is put back and the philosopher
+                   backs off for a randomized, exponentially growing delay (BackoffPolicy).
+    - Arbiter:     philosophers send requests and releases to a central arbiter thread over
+                   a lock-free MPMC queue (see mpmc_queue.h); the arbiter owns the fork state
+                   and grants both forks at once, in batches (see ArbiterStats).
+*/
+
+#pragma once
+
+#include "chopstick.h"
+#include "metrics.h"
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <stop_token>
+#include <string>
+#include <utility>
+
+enum class StrategyKind {
+    Asymmetric,
+    Hierarchy,
+    Waiter,
+    ChandyMisra,
+    CasBitmap,
+    Naive,
+    Backoff,
+    Arbiter
+};
+
+// Tuning of the backoff strategy, --backoff=TRY:MIN:MAX
+struct BackoffPolicy {
+    std::chrono::nanoseconds tryFor{std::chrono::microseconds(100)};   // Wait for the second chopstick
+    std::chrono::nanoseconds minDelay{std::chrono::microseconds(10)};  // Delay ceiling after the first failure
+    std::chrono::nanoseconds maxDelay{std::chrono::milliseconds(5)};   // Cap of the doubling ceiling
+
+    /*
+        Function: parse
+        ---------------
+        Parses "TRY:MIN:MAX" durations (see DurationModel for the units). Throws
+        std::invalid_argument when malformed or when MIN exceeds MAX.
+    */
+    static BackoffPolicy parse(const std::string& spec);
+
+    // Canonical spec, e.g. "100000ns:10000ns:5000000ns"
+    std::string describe() const;
+};
+
+// A philosopher's place at the table
+struct Seat {
+    int id;     // Philosopher ID
+    int left;   // Index of the left chopstick
+    int right;  // Index of the right chopstick
+    PhilosopherStats* stats = nullptr;  // Owner's counters, updated by the strategy if set
+};
+
+// Saturation counters of the arbiter thread, readable while it runs
+struct ArbiterStats {
+    std::uint64_t messages = 0;    // Requests and releases taken off the queue
+    std::uint64_t grants = 0;      // Fork pairs handed out
+    std::uint64_t batches = 0;     // Passes that found messages; each ends with one grant pass
+    std::uint64_t maxBatch = 0;    // Most messages served in one pass
+    std::uint64_t maxPending = 0;  // Most requests waiting for a fork after a grant pass
+    std::uint64_t parks = 0;       // Times the arbiter slept on an empty queue
+    std::chrono::nanoseconds busy{0};      // Time spent serving batches
+    std::chrono::nanoseconds lifetime{0};  // Time since the arbiter started
+};
+
+class AcquisitionStrategy {
+public:
+    virtual ~AcquisitionStrategy() = default;
+
+    // Counters of the arbiter strategy; none for the others
+    virtual std::optional<ArbiterStats> arbiterStats() const { return std::nullopt; }
+
+    // Blocks until the philosopher holds both chopsticks (true), or until a stop is requested
+    // on the token (false; the philosopher then holds no chopstick)
+    virtual bool acquire(const Seat& seat, const std::stop_token& stop) = 0;
+
+    // Puts down both chopsticks
+    virtual void release(const Seat& seat) = 0;
+};
+
+/*
+    Function: makeStrategy
+    ----------------------
+    Creates the strategy for a table of numPhilosophers seats. Chopstick-based strategies
+    allocate and own a table of the selected primitive, with chopstick i placed on NUMA node
+    chopstickNode(i) if given (see numa_array.h); Chandy-Misra and the CAS bitmap keep their
+    own fork state and ignore the primitive and the placement, as does the arbiter, whose
+    thread starts here. Only the backoff strategy uses the backoff policy and the seed, from
+    which it derives every seat's random stream of delays.
+*/
+std::unique_ptr<AcquisitionStrategy> makeStrategy(StrategyKind kind, ChopstickKind chopstick, int numPhilosophers,
+                                                  const std::function<int(int)>& chopstickNode = {},
+                                                  const BackoffPolicy& backoff = {}, std::uint64_t seed = 1);
+
+/*
+    Function: strategyName
+    ----------------------
+    Returns the command-line name of a strategy.
+*/
+std::string strategyName(StrategyKind kind);
+
+/*
+    Function: pickUpOrder
+    ---------------------
+    Order in which an ordering strategy (asymmetric, hierarchy, waiter) picks up the seat's
+    chopsticks, as {first, second}. Used by the executors that schedule philosophers as tasks.
+*/
+std::pair<int, int> pickUpOrder(StrategyKind kind, const Seat& seat);
+
+/*
+    Function: notePickedUp
+    ----------------------
+    Reports that a philosopher picked up one of its chopsticks. Called by the strategies; the
+    first pickup of an acquisition starts the seat's half-held clock.
+*/
+void notePickedUp(const Seat& seat, int chopstick);
+
+/*
+    Function: noteFailedTryAcquire
+    ------------------------------
+    Reports that a non-blocking attempt on one of the seat's chopsticks found it taken.
+    Counted per side of the seat, so that the metrics endpoint can attribute the contention
+    to the chopstick.
+*/
+void noteFailedTryAcquire(const Seat& seat, int chopstick);
+
+/*
+    Function: noteBlockedOn
+    -----------------------
+    Publishes that the philosopher is about to block on one of its chopsticks, holding the
+    other one if it already picked it up, for the deadlock detector. A single relaxed store;
+    recordAcquisition() clears it.
+*/
+void noteBlockedOn(const Seat& seat, int chopstick);
@@ -0,0 +1,516 @@
+#include "sweep.h"
+#include "json_writer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
+
+namespace {
+
+constexpr int POLL_MS = 100;  // How quickly a running child hears of an interrupt
+
+// Options of the sweep itself, not forwarded to its runs
+const char* const SWEEP_OPTIONS[] = {"mode", "sweep", "shard", "sweep-format", "jobs"};
+
+// Report members in the CSV, by path; each mode reports a subset of them
+const char* const CSV_METRICS[] = {
+    "total_meals",         "meals_per_sec",       "meals_per_virtual_sec", "hungry_wait_ns.mean",
+    "hungry_wait_ns.p50",  "hungry_wait_ns.p99",  "hungry_wait_ns.p999",   "hungry_wait_ns.max",
+    "failed_try_acquires", "fairness.jain_meals", "fairness.min_meals",    "fairness.max_meals"};
+
+volatile std::sig_atomic_t sweepInterrupted = 0;
+
+extern "C" void onSweepSignal(int) {
+    sweepInterrupted = 1;
+}
+
+struct GridPoint {
+    int index = 0;
+    std::string mode = "bench";
+    std::vector<std::string> values;  // One per axis
+    std::vector<std::string> args;    // Command line of the run, argv[0] first
+};
+
+struct RunOutcome {
+    std::string status;  // ok, interrupted, exit N, signal N or an error
+    std::string report;  // The run's stdout
+    double wallSeconds = 0.0;
+};
+
+/*
+    Class: ReportFields
+    -------------------
+    The scalar members of a JSON report by dotted path, e.g. "hungry_wait_ns.p99", with
+    strings unquoted. Arrays are skipped, and null members are left out like missing ones
+    (the JsonWriter's non-finite doubles). Throws std::runtime_error on malformed JSON.
+*/
+class ReportFields {
+public:
+    explicit ReportFields(const std::string& text) : text_(text) {
+        parseValue("", true);
+        skipSpace();
+        if (pos_ != text_.size()) {
+            fail();
+        }
+    }
+
+    std::string get(const std::string& path) const {
+        const auto field = fields_.find(path);
+        return field == fields_.end() ? std::string() : field->second;
+    }
+
+private:
+    [[noreturn]] void fail() const {
+        throw std::runtime_error("malformed report at offset " + std::to_string(pos_));
+    }
+
+    char peek() const { return pos_ < text_.size() ? text_[pos_] : '\0'; }
+
+    void skipSpace() {
+        while (pos_ < text_.size() && std::strchr(" \t\r\n", text_[pos_]) != nullptr) {
+            pos_++;
+        }
+    }
+
+    void expect(const char c) {
+        skipSpace();
+        if (peek() != c) {
+            fail();
+        }
+        pos_++;
+    }
+
+    std::string parseString() {
+        expect('"');
+        std::string result;
+        while (peek() != '"') {
+            char c = peek();
+            if (c == '\0') {
+                fail();
+            }
+            pos_++;
+            if (c == '\\') {
+                c = peek();
+                pos_++;
+                if (c == 'u') {
+                    pos_ += 4;  // Reports only escape control characters
+                    c = '?';
+                } else if (c == 'n') {
+                    c = '\n';
+                } else if (c == 't') {
+                    c = '\t';
+                }
+            }
+            result += c;
+        }
+        pos_++;
+        return result;
+    }
+
+    // Parses the value at pos_, storing it under path if it is a scalar and keep is set
+    void parseValue(const std::string& path, const bool keep) {
+        skipSpace();
+        const char c = peek();
+        if (c == '{' || c == '[') {
+            const bool object = c == '{';
+            const char close = object ? '}' : ']';
+            pos_++;
+            skipSpace();
+            if (peek() == close) {
+                pos_++;
+                return;
+            }
+            while (true) {
+                if (object) {
+                    const std::string key = parseString();
+                    expect(':');
+                    parseValue(path.empty() ? key : path + "." + key, keep);
+                } else {
+                    parseValue(path, false);
+                }
+                skipSpace();
+                if (peek() != ',') {
+                    break;
+                }
+                pos_++;
+                skipSpace();
+            }
+            expect(close);
+            return;
+        }
+
+        std::string scalar;
+        if (c == '"') {
+            scalar = parseString();
+        } else {
+            const std::size_t start = pos_;
+            while (pos_ < text_.size() && std::strchr(",}] \t\r\n", text_[pos_]) == nullptr) {
+                pos_++;
+            }
+            if (pos_ == start) {
+                fail();
+            }
+            scalar = text_.substr(start, pos_ - start);
+            if (scalar == "null") {
+                return;
+            }
+        }
+        if (keep) {
+            fields_[path] = scalar;
+        }
+    }
+
+    const std::string& text_;
+    std::size_t pos_ = 0;
+    std::map<std::string, std::string> fields_;
+};
+
+std::string optionName(const std::string& arg) {
+    const std::string name = arg.substr(2);
+    return name.substr(0, name.find('='));
+}
+
+bool isSweepOption(const std::string& name) {
+    return std::find(std::begin(SWEEP_OPTIONS), std::end(SWEEP_OPTIONS), name) != std::end(SWEEP_OPTIONS);
+}
+
+// The sweep's arguments without its own options; parseArgs() accepted them already
+std::vector<std::string> baseArgs(const int argc, char* argv[]) {
+    std::vector<std::string> args;
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        const bool separateValue = arg.find('=') == std::string::npos && i + 1 < argc;
+        if (isSweepOption(optionName(arg))) {
+            i += separateValue ? 1 : 0;
+            continue;
+        }
+        args.push_back(arg);
+        if (separateValue) {
+            args.push_back(argv[++i]);
+        }
+    }
+    return args;
+}
+
+// Every point of the grid in index order, the last axis varying fastest
+std::vector<GridPoint> expandGrid(const Config& config, const std::string& program,
+                                  const std::vector<std::string>& base) {
+    std::size_t size = 1;
+    for (const SweepAxis& axis : config.sweep) {
+        if (isSweepOption(axis.name) && axis.name != "mode") {
+            throw std::invalid_argument("--" + axis.name + " cannot be a sweep axis");
+        }
+        size *= axis.values.size();
+        if (size > 1'000'000) {
+            throw std::invalid_argument("the sweep grid has more than 1000000 points");
+        }
+    }
+
+    std::vector<GridPoint> points(size);
+    for (std::size_t index = 0; index < size; index++) {
+        GridPoint& point = points[index];
+        point.index = static_cast<int>(index);
+        std::vector<std::string> settings;
+        std::size_t rest = index;
+        for (auto axis = config.sweep.rbegin(); axis != config.sweep.rend(); ++axis) {
+            const std::string& value = axis->values[rest % axis->values.size()];
+            rest /= axis->values.size();
+            point.values.insert(point.values.begin(), value);
+            if (axis->name == "mode") {
+                point.mode = value;
+            } else {
+                settings.insert(settings.begin(), "--" + axis->name + "=" + value);
+            }
+        }
+        if (point.mode != "bench" && point.mode != "des" && point.mode != "graph-bench") {
+            throw std::invalid_argument("sweep runs must be in bench, des or graph-bench mode, not '" + point.mode + "'");
+        }
+        point.args.push_back(program);
+        point.args.insert(point.args.end(), base.begin(), base.end());
+        point.args.push_back("--mode=" + point.mode);
+        point.args.insert(point.args.end(), settings.begin(), settings.end());
+    }
+    return points;
+}
+
+// Checks a run's command line as the child will parse it
+void validate(const GridPoint& point) {
+    std::vector<char*> argv;
+    for (const std::string& arg : point.args) {
+        argv.push_back(const_cast<char*>(arg.c_str()));
+    }
+    try {
+        parseArgs(static_cast<int>(argv.size()), argv.data());
+    } catch (const std::invalid_argument& e) {
+        throw std::invalid_argument("grid point " + std::to_string(point.index) + ": " + e.what());
+    }
+}
+
+std::string describe(const Config& config, const GridPoint& point) {
+    std::string text;
+    for (std::size_t i = 0; i < config.sweep.size(); i++) {
+        text += (i == 0 ? "" : " ") + config.sweep[i].name + "=" + point.values[i];
+    }
+    return text;
+}
+
+// Runs the point in a child process of this binary and collects its stdout
+RunOutcome runPoint(const GridPoint& point) {
+    RunOutcome outcome;
+    const auto start = std::chrono::steady_clock::now();
+
+    int pipeFds[2];
+    if (::pipe2(pipeFds, O_CLOEXEC) != 0) {
+        outcome.status = std::string("cannot create pipe: ") + std::strerror(errno);
+        return outcome;
+    }
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, pipeFds[1], STDOUT_FILENO);
+    std::vector<char*> argv;
+    for (const std::string& arg : point.args) {
+        argv.push_back(const_cast<char*>(arg.c_str()));
+    }
+    argv.push_back(nullptr);
+    pid_t pid = 0;
+    const int error = posix_spawn(&pid, "/proc/self/exe", &actions, nullptr, argv.data(), environ);
+    posix_spawn_file_actions_destroy(&actions);
+    ::close(pipeFds[1]);
+    if (error != 0) {
+        ::close(pipeFds[0]);
+        outcome.status = std::string("cannot start run: ") + std::strerror(error);
+        return outcome;
+    }
+
+    bool forwarded = false;
+    char buffer[4096];
+    while (true) {
+        if (sweepInterrupted != 0 && !forwarded) {
+            ::kill(pid, SIGTERM);
+            forwarded = true;
+        }
+        pollfd output{pipeFds[0], POLLIN, 0};
+        if (::poll(&output, 1, POLL_MS) <= 0) {
+            continue;
+        }
+        const ssize_t received = ::read(pipeFds[0], buffer, sizeof(buffer));
+        if (received < 0 && errno == EINTR) {
+            continue;
+        }
+        if (received <= 0) {
+            break;
+        }
+        outcome.report.append(buffer, static_cast<std::size_t>(received));
+    }
+    ::close(pipeFds[0]);
+
+    int status = 0;
+    while (::waitpid(pid, &status, 0) < 0 && errno == EINTR) {
+    }
+    outcome.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (WIFSIGNALED(status)) {
+        outcome.status = "signal " + std::to_string(WTERMSIG(status));
+    } else if (WEXITSTATUS(status) != 0) {
+        outcome.status = "exit " + std::to_string(WEXITSTATUS(status));
+    } else {
+        outcome.status = forwarded ? "interrupted" : "ok";
+    }
+    return outcome;
+}
+
+std::string csvField(const std::string& text) {
+    if (text.find_first_of(",\"\n") == std::string::npos) {
+        return text;
+    }
+    std::string quoted = "\"";
+    for (const char c : text) {
+        quoted += c == '"' ? "\"\"" : std::string(1, c);
+    }
+    return quoted + "\"";
+}
+
+void writeCsv(const Config& config, const std::vector<GridPoint>& points, const std::vector<int>& selected,
+              const std::vector<RunOutcome>& outcomes) {
+    std::cout << "index";
+    for (const SweepAxis& axis : config.sweep) {
+        std::cout << "," << csvField(axis.name);
+    }
+    std::cout << ",status,wall_s";
+    for (const char* metric : CSV_METRICS) {
+        std::cout << "," << metric;
+    }
+    std::cout << "\n";
+
+    for (std::size_t i = 0; i < selected.size(); i++) {
+        const GridPoint& point = points[selected[i]];
+        const RunOutcome& outcome = outcomes[i];
+        if (outcome.status.empty()) {
+            continue;  // Never started
+        }
+        std::cout << point.index;
+        for (const std::string& value : point.values) {
+            std::cout << "," << csvField(value);
+        }
+        std::string status = outcome.status;
+        std::vector<std::string> metrics(std::size(CSV_METRICS));
+        try {
+            const ReportFields fields(outcome.report);
+            for (std::size_t m = 0; m < metrics.size(); m++) {
+                metrics[m] = fields.get(CSV_METRICS[m]);
+            }
+        } catch (const std::runtime_error&) {
+            status = status == "ok" ? "bad report" : status;
+        }
+        char wall[32];
+        std::snprintf(wall, sizeof(wall), "%.3f", outcome.wallSeconds);
+        std::cout << "," << csvField(status) << "," << wall;
+        for (const std::string& metric : metrics) {
+            std::cout << "," << csvField(metric);
+        }
+        std::cout << "\n";
+    }
+    std::cout.flush();
+}
+
+void writeJson(const Config& config, const std::size_t gridSize, const std::vector<GridPoint>& points,
+               const std::vector<int>& selected, const std::vector<RunOutcome>& outcomes) {
+    JsonWriter json(std::cout);
+    json.beginObject()
+        .field("shard", config.shard.describe())
+        .field("grid_points", static_cast<std::uint64_t>(gridSize));
+    json.key("axes").beginArray();
+    for (const SweepAxis& axis : config.sweep) {
+        json.value(axis.name);
+    }
+    json.endArray();
+    json.key("runs").beginArray();
+    for (std::size_t i = 0; i < selected.size(); i++) {
+        const GridPoint& point = points[selected[i]];
+        const RunOutcome& outcome = outcomes[i];
+        if (outcome.status.empty()) {
+            continue;
+        }
+        json.beginObject().field("index", point.index);
+        json.key("settings").beginObject();
+        for (std::size_t a = 0; a < config.sweep.size(); a++) {
+            json.field(config.sweep[a].name, point.values[a]);
+        }
+        json.endObject();
+        json.field("status", outcome.status).field("wall_s", outcome.wallSeconds);
+
+        // Embedded as is if it parses, so that one broken run keeps the document valid
+        std::string report = outcome.report;
+        report.erase(report.find_last_not_of(" \t\r\n") + 1);
+        try {
+            const ReportFields check(report);
+            json.key("report").raw(report);
+        } catch (const std::runtime_error&) {
+            json.key("report").raw("null");
+        }
+        json.endObject();
+    }
+    json.endArray();
+    json.endObject();
+    std::cout.flush();
+}
+
+}  // namespace
+
+int runSweep(const Config& config, const int argc, char* argv[]) {
+    std::vector<GridPoint> points;
+    try {
+        points = expandGrid(config, argv[0], baseArgs(argc, argv));
+        for (const GridPoint& point : points) {
+            validate(point);
+        }
+    } catch (const std::invalid_argument& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    // This shard's points; outcomes are kept in the same order
+    std::vector<int> selected;
+    for (const GridPoint& point : points) {
+        if (config.shard.contains(point.index)) {
+            selected.push_back(point.index);
+        }
+    }
+    std::vector<RunOutcome> outcomes(selected.size());
+
+    sweepInterrupted = 0;
+    const auto previousInt = std::signal(SIGINT, onSweepSignal);
+    const auto previousTerm = std::signal(SIGTERM, onSweepSignal);
+
+    std::mutex progressMutex;
+    int done = 0;
+    const auto run = [&](const std::size_t slot) {
+        const GridPoint& point = points[selected[slot]];
+        outcomes[slot] = runPoint(point);
+        const std::lock_guard<std::mutex> lock(progressMutex);
+        done++;
+        std::fprintf(stderr, "[%d/%zu] #%d %s: %s, %.2f s\n", done, selected.size(), point.index,
+                     describe(config, point).c_str(), outcomes[slot].status.c_str(), outcomes[slot].wallSeconds);
+    };
+
+    // Virtual-time runs first, several at a time
+    std::vector<std::size_t> desSlots;
+    std::vector<std::size_t> timedSlots;
+    for (std::size_t slot = 0; slot < selected.size(); slot++) {
+        (points[selected[slot]].mode == "des" ? desSlots : timedSlots).push_back(slot);
+    }
+    const int jobs = config.jobs == 0 ? static_cast<int>(std::max(1U, std::thread::hardware_concurrency())) : config.jobs;
+    std::atomic<std::size_t> nextDes{0};
+    {
+        std::vector<std::jthread> workers;
+        for (int w = 0; w < std::min<int>(jobs, static_cast<int>(desSlots.size())); w++) {
+            workers.emplace_back([&] {
+                for (std::size_t i = nextDes++; i < desSlots.size() && sweepInterrupted == 0; i = nextDes++) {
+                    run(desSlots[i]);
+                }
+            });
+        }
+    }
+
+    // Wall-clock runs one at a time, so that they measure an otherwise idle machine
+    for (const std::size_t slot : timedSlots) {
+        if (sweepInterrupted != 0) {
+            break;
+        }
+        run(slot);
+    }
+
+    std::signal(SIGINT, previousInt);
+    std::signal(SIGTERM, previousTerm);
+
+    if (config.sweepFormat == SweepFormat::Csv) {
+        writeCsv(config, points, selected, outcomes);
+    } else {
+        writeJson(config, points.size(), points, selected, outcomes);
+    }
+
+    const auto failed = std::count_if(outcomes.begin(), outcomes.end(),
+                                      [](const RunOutcome& outcome) { return outcome.status != "ok"; });
+    if (sweepInterrupted != 0) {
+        std::fprintf(stderr, "Sweep interrupted: %d of %zu runs done\n", done, selected.size());
+    }
+    return failed == 0 ? 0 : 1;
+}
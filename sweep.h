@@ -0,0 +1,39 @@
+/*
+    Sweep
+    -----
+    Parameter sweep over a grid of configurations, for comparing strategies, table sizes,
+    think/eat distributions and primitives without launching every combination by hand.
+
+    The grid is the cartesian product of the --sweep axes, each the values of one
+    command-line option; every other option on the command line applies to all runs. Each
+    grid point runs in a child process of the same binary, in bench mode unless "mode" is an
+    axis (bench, des and graph-bench), so runs cannot disturb each other's counters, heap or
+    chopsticks and a crashing run only loses its own row. Every point is checked with
+    parseArgs() before the first run starts.
+
+    Runs in virtual time (des) are independent of the machine's load, so they run --jobs at
+    a time. Wall-clock runs measure the machine and run one at a time, after the des runs.
+    SIGINT or SIGTERM stops the sweep: running children get a SIGTERM, which bench runs
+    handle by ending early with a report, and no new run starts.
+
+    --shard=I/N keeps the grid points whose index is I modulo N, so N hosts can split one
+    grid. The index of every point is part of the results, so the result sets of all shards
+    can be merged and sorted.
+*/
+
+#pragma once
+
+#include "config.h"
+
+/*
+    Function: runSweep
+    ------------------
+    Runs this shard's points of the grid in config.sweep and prints the result set to stdout:
+    - csv: one row per run, with the grid index, the axis values, the run's status and wall
+      time, and the main metrics of its report (empty where its mode has none),
+    - json: a document with the shard and every run, each with its complete report.
+    argv are the sweep's own arguments, forwarded to every run without the sweep options.
+    Progress goes to stderr. Returns the process exit code: 1 if a point is invalid, a run
+    failed or the sweep was interrupted.
+*/
+int runSweep(const Config& config, int argc, char* argv[]);
@@ -0,0 +1,232 @@
+#include "task_philosopher.h"
+#include "async_semaphore.h"
+#include "logger.h"
+#include "numa_array.h"
+#include "task_pool.h"
+#include "timer_queue.h"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+long long elapsedMs(const Clock::time_point since) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - since).count();
+}
+
+class PhilosopherTask;
+
+// Everything the philosopher tasks of one run share
+struct TaskTable {
+    TaskTable(DiningTable& table, int numWorkers);
+
+    DiningTable& table;
+    std::vector<std::unique_ptr<PhilosopherTask>> philosophers;  // Destroyed after the pool stopped
+    NumaArray<AsyncSemaphore> chopsticks;  // Chopstick i on the node of the worker seating philosopher i
+    std::unique_ptr<AsyncSemaphore> admissions;  // The waiter's N-1 seats, waiter strategy only
+    TaskPool pool;
+    TimerQueue timers;
+};
+
+/*
+    Class: PhilosopherTask
+    ----------------------
+    One philosopher between steps. Every step that may suspend sets the step to resume at
+    first and suspends as its very last action: once the task is linked into a waiter list or
+    the timer queue, another worker may already be running it.
+*/
+class PhilosopherTask final : public TaskPool::Task, public AsyncWaiter {
+public:
+    PhilosopherTask(TaskTable& tasks, const int philosopherID)
+        : tasks_(tasks),
+          seat_(seatOf(tasks.table, philosopherID)),
+          rng_(tasks.table.seed * 0x9e3779b97f4a7c15ULL + static_cast<std::uint64_t>(philosopherID)) {
+        seat_.stats = &tasks.table.stats[philosopherID];
+        std::tie(first_, second_) = pickUpOrder(tasks.table.strategyKind, seat_);
+    }
+
+    void run() override {
+        const std::stop_token stop = tasks_.pool.stopToken();
+        const int id = seat_.id;
+
+        while (!stop.stop_requested()) {
+            switch (step_) {
+                case Step::Think:
+                    logEvent(id, Event::Thinking);
+                    stepStarted_ = Clock::now();
+                    step_ = Step::Hungry;
+                    if (suspendFor(tasks_.table.thinkModels[id], stop)) {
+                        return;
+                    }
+                    break;
+
+                case Step::Hungry:
+                    logEvent(id, Event::Thought, -1, elapsedMs(stepStarted_));
+                    logEvent(id, Event::Hungry);
+                    hungrySince_ = startHungryWait(*seat_.stats);
+                    step_ = Step::PickFirst;
+                    if (tasks_.admissions != nullptr && !tasks_.admissions->acquireOrEnqueue(*this)) {
+                        return;
+                    }
+                    break;
+
+                case Step::PickFirst:
+                    step_ = Step::PickedFirst;
+                    if (!pickUp(first_)) {
+                        return;
+                    }
+                    break;
+
+                case Step::PickedFirst:
+                    notePickedUp(seat_, first_);
+                    step_ = Step::PickedSecond;
+                    if (!pickUp(second_)) {
+                        return;
+                    }
+                    break;
+
+                case Step::PickedSecond:
+                    notePickedUp(seat_, second_);
+                    recordAcquisition(*seat_.stats, hungrySince_, Clock::now());
+                    courses_ = 0;
+                    step_ = Step::Eat;
+                    break;
+
+                case Step::Eat:
+                    logEvent(id, Event::Eating);
+                    stepStarted_ = Clock::now();
+                    step_ = Step::Ate;
+                    if (suspendFor(tasks_.table.eatModels[id], stop)) {
+                        return;
+                    }
+                    break;
+
+                case Step::Ate:
+                    logEvent(id, Event::Ate, -1, elapsedMs(stepStarted_));
+                    bump(seat_.stats->meals);
+                    if (eatAnotherCourse(tasks_.table, id, ++courses_)) {
+                        step_ = Step::Eat;
+                        break;
+                    }
+                    putDown();
+                    if (tasks_.table.mealLimit != 0 &&
+                        seat_.stats->meals.load(std::memory_order_relaxed) >= tasks_.table.mealLimit) {
+                        tasks_.table.finished.fetch_add(1, std::memory_order_release);
+                        return;  // Leaves the table for good
+                    }
+                    step_ = Step::Think;
+                    tasks_.pool.submit(*this);  // Yield the worker between meals
+                    return;
+            }
+        }
+    }
+
+    // Handed a chopstick or a waiter seat by a release
+    void wake() override { tasks_.pool.submit(*this); }
+
+private:
+    enum class Step {
+        Think,         // Start thinking
+        Hungry,        // Done thinking; ask the waiter for a seat if there is one
+        PickFirst,     // Reach for the first chopstick
+        PickedFirst,   // Holding the first chopstick; reach for the second
+        PickedSecond,  // Holding both
+        Eat,           // Start a course
+        Ate            // Done with a course; eat another or put both chopsticks down
+    };
+
+    // Waits out a think or eat period. True if the task is now suspended on the timer queue.
+    bool suspendFor(const DurationModel& model, const std::stop_token& stop) {
+        const std::chrono::nanoseconds duration = model.sample(rng_);
+        if (model.kind() == DurationModel::Kind::Spin) {
+            spinFor(duration, stop);
+            return false;
+        }
+        if (duration <= std::chrono::nanoseconds::zero()) {
+            return false;
+        }
+        tasks_.timers.schedule(Clock::now() + duration, *this);
+        return true;
+    }
+
+    // Takes the chopstick (true) or suspends until a neighbour hands it over (false)
+    bool pickUp(const int chopstick) {
+        AsyncSemaphore& semaphore = tasks_.chopsticks[chopstick];
+        if (semaphore.tryAcquire()) {
+            return true;
+        }
+        noteFailedTryAcquire(seat_, chopstick);
+        noteBlockedOn(seat_, chopstick);
+        return semaphore.acquireOrEnqueue(*this);
+    }
+
+    void putDown() {
+        logEvent(seat_.id, Event::PutDown);  // Before a neighbour can pick up
+        tasks_.chopsticks[seat_.left].release();
+        tasks_.chopsticks[seat_.right].release();
+        if (tasks_.admissions != nullptr) {
+            tasks_.admissions->release();
+        }
+    }
+
+    TaskTable& tasks_;
+    Seat seat_;
+    int first_;
+    int second_;
+    std::mt19937_64 rng_;
+    Step step_ = Step::Think;
+    int courses_ = 0;  // Courses since the chopsticks were picked up
+    Clock::time_point stepStarted_{};
+    Clock::time_point hungrySince_{};
+};
+
+TaskTable::TaskTable(DiningTable& table, const int numWorkers)
+    : table(table),
+      chopsticks(table.numPhilosophers,
+                 [&](const int chopstick) { return table.placement.nodeFor(chopstick % numWorkers, numWorkers); }),
+      admissions(table.strategyKind == StrategyKind::Waiter
+                     ? std::make_unique<AsyncSemaphore>(table.numPhilosophers - 1)
+                     : nullptr),
+      pool(numWorkers, [&table, numWorkers](const int worker) {
+          // Philosophers are first spread round-robin, so worker w starts with seats w, w + n, ...
+          if (table.placement.pinCurrentThread(worker, numWorkers)) {
+              table.pinned.fetch_add(1, std::memory_order_relaxed);
+          }
+      }),
+      timers(pool) {
+    philosophers.reserve(table.numPhilosophers);
+    for (int i = 0; i < table.numPhilosophers; i++) {
+        philosophers.push_back(std::make_unique<PhilosopherTask>(*this, i));
+    }
+}
+
+}  // namespace
+
+RunResult runPhilosopherTasks(DiningTable& table, const std::chrono::milliseconds duration, int numWorkers) {
+    if (numWorkers == 0) {
+        numWorkers = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+    TaskTable tasks(table, std::min(numWorkers, table.numPhilosophers));
+
+    const auto start = Clock::now();
+    for (auto& philosopher : tasks.philosophers) {
+        tasks.pool.submit(*philosopher);
+    }
+
+    waitForRunEnd(table, start, duration);
+
+    // Workers finish their current step; suspended philosophers simply stay suspended
+    tasks.pool.stop();
+
+    RunResult result;
+    result.elapsed = Clock::now() - start;
+    result.workers = tasks.pool.size();
+    result.steals = tasks.pool.steals();
+    return result;
+}
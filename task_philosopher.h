@@ -0,0 +1,30 @@
+/*
+    TaskPhilosopher
+    ---------------
+    M:N execution of the table: philosophers are small state machines run as tasks on a
+    TaskPool sized to the hardware, instead of one OS thread each.
+
+    A philosopher never blocks its worker. Reaching for a taken chopstick links the task into
+    the chopstick's waiter list (see async_semaphore.h) and the worker moves on; the releasing
+    neighbour hands the chopstick over and resubmits the task. Thinking and eating put the
+    task on a TimerQueue, except for spin durations, which are real work and run in place.
+    After every meal a philosopher yields its worker so a long-running table stays fair.
+
+    The ordering strategies map directly onto task chopsticks: asymmetric and hierarchy pick
+    the same order as their threaded versions, and the waiter becomes a task semaphore with
+    N-1 permits. Chandy-Misra and the CAS bitmap have no task form.
+*/
+
+#pragma once
+
+#include "philosopher.h"
+
+#include <chrono>
+
+/*
+    Function: runPhilosopherTasks
+    -----------------------------
+    Runs the table on a pool of numWorkers threads (0 = hardware concurrency, never more than
+    the number of philosophers) until waitForRunEnd() returns, then stops the pool.
+*/
+RunResult runPhilosopherTasks(DiningTable& table, std::chrono::milliseconds duration, int numWorkers);
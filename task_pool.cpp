@@ -0,0 +1,118 @@
+#include "task_pool.h"
+
+#include <utility>
+
+namespace {
+
+// Pool and deque index of the worker running on this thread, if any
+thread_local const TaskPool* currentPool = nullptr;
+thread_local int currentWorker = -1;
+
+}  // namespace
+
+TaskPool::TaskPool(const int numWorkers, std::function<void(int)> onWorkerStart)
+    : onWorkerStart_(std::move(onWorkerStart)) {
+    workers_.reserve(numWorkers);
+    for (int i = 0; i < numWorkers; i++) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+    // Started only once every deque exists, since workers steal from all of them
+    for (int i = 0; i < numWorkers; i++) {
+        workers_[i]->thread = std::thread(&TaskPool::work, this, i);
+    }
+}
+
+TaskPool::~TaskPool() {
+    stop();
+}
+
+void TaskPool::submit(Task& task) {
+    int index = currentWorker;
+    if (currentPool != this) {
+        index = static_cast<int>(nextWorker_.fetch_add(1, std::memory_order_relaxed) % workers_.size());
+    }
+    {
+        Worker& worker = *workers_[index];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.ready.push_back(&task);
+    }
+    // Sequentially consistent with the parked_ increment in work(), so no wake-up is lost
+    sequence_.fetch_add(1);
+    if (parked_.load() != 0) {
+        sequence_.notify_one();
+    }
+}
+
+void TaskPool::stop() {
+    if (!stopSource_.request_stop()) {
+        return;
+    }
+    sequence_.fetch_add(1);
+    sequence_.notify_all();
+    for (auto& worker : workers_) {
+        worker->thread.join();
+    }
+}
+
+std::uint64_t TaskPool::steals() const {
+    std::uint64_t total = 0;
+    for (const auto& worker : workers_) {
+        total += worker->steals.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void TaskPool::work(const int index) {
+    currentPool = this;
+    currentWorker = index;
+    if (onWorkerStart_) {
+        onWorkerStart_(index);
+    }
+    const std::stop_token stop = stopSource_.get_token();
+
+    while (!stop.stop_requested()) {
+        if (Task* task = take(index)) {
+            task->run();
+            continue;
+        }
+
+        // Park: announce, read the sequence, then re-check so a concurrent submit is seen
+        parked_.fetch_add(1);
+        const std::uint32_t seen = sequence_.load();
+        Task* task = stop.stop_requested() ? nullptr : take(index);
+        if (task == nullptr && !stop.stop_requested()) {
+            sequence_.wait(seen);
+        }
+        parked_.fetch_sub(1);
+        if (task != nullptr) {
+            task->run();
+        }
+    }
+}
+
+TaskPool::Task* TaskPool::take(const int index) {
+    {
+        Worker& own = *workers_[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.ready.empty()) {
+            Task* task = own.ready.front();
+            own.ready.pop_front();
+            return task;
+        }
+    }
+
+    // Steal the newest task of the next non-empty deque
+    const int numWorkers = static_cast<int>(workers_.size());
+    for (int offset = 1; offset < numWorkers; offset++) {
+        Worker& victim = *workers_[(index + offset) % numWorkers];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.ready.empty()) {
+            Task* task = victim.ready.back();
+            victim.ready.pop_back();
+            Worker& own = *workers_[index];
+            own.steals.store(own.steals.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return task;
+        }
+    }
+    return nullptr;
+}
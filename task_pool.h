@@ -0,0 +1,79 @@
+/*
+    TaskPool
+    --------
+    Fixed pool of worker threads running lightweight tasks, with work stealing.
+
+    Every worker owns a deque of ready tasks. A worker pushes the tasks it wakes onto its own
+    deque, so a philosopher handed a chopstick by its neighbour runs on the core that still
+    has the chopstick's line in cache. The owner runs its deque in submission order, which
+    gives every ready task its turn; an idle worker steals from the back of the other deques.
+    Tasks submitted from outside the pool are spread round-robin. Workers with nothing to run
+    or steal park on an event count that submitters only signal while a worker is parked.
+
+    A task runs until it has to wait and then returns from run(); whoever ends the wait
+    submits it again. A task is never queued twice at the same time.
+*/
+
+#pragma once
+
+#include "cache_line.h"
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+class TaskPool {
+public:
+    class Task {
+    public:
+        virtual ~Task() = default;
+
+        // Runs the task until it has to wait
+        virtual void run() = 0;
+    };
+
+    // onWorkerStart runs on each worker thread, with the worker's index, before it takes a task
+    explicit TaskPool(int numWorkers, std::function<void(int)> onWorkerStart = {});
+    ~TaskPool();
+
+    TaskPool(const TaskPool&) = delete;
+    TaskPool& operator=(const TaskPool&) = delete;
+
+    // Makes a task ready to run. Safe to call from any thread.
+    void submit(Task& task);
+
+    // Stops the workers after their current task and joins them. Queued tasks are dropped.
+    void stop();
+
+    int size() const { return static_cast<int>(workers_.size()); }
+
+    // Tasks taken from another worker's deque so far
+    std::uint64_t steals() const;
+
+    // Stop token of the pool: requested once stop() was called
+    std::stop_token stopToken() const { return stopSource_.get_token(); }
+
+private:
+    struct alignas(CACHE_LINE_SIZE) Worker {
+        std::mutex mutex;
+        std::deque<Task*> ready;
+        std::atomic<std::uint64_t> steals{0};
+        std::thread thread;
+    };
+
+    void work(int index);
+    Task* take(int index);
+
+    std::function<void(int)> onWorkerStart_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::stop_source stopSource_;
+    alignas(CACHE_LINE_SIZE) std::atomic<std::uint32_t> sequence_{0};  // Bumped on every submit
+    std::atomic<std::uint32_t> parked_{0};
+    std::atomic<std::uint32_t> nextWorker_{0};  // Round-robin target of outside submits
+};
@@ -0,0 +1,56 @@
+#include "timer_queue.h"
+
+#include <optional>
+#include <vector>
+
+TimerQueue::TimerQueue(TaskPool& pool)
+    : pool_(pool), thread_([this](const std::stop_token stop) { run(stop); }) {}
+
+TimerQueue::~TimerQueue() {
+    thread_.request_stop();
+    thread_.join();
+}
+
+void TimerQueue::schedule(const Clock::time_point deadline, TaskPool::Task& task) {
+    bool earlier = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        timers_.schedule(deadline, &task);
+        if (deadline < plannedWakeUp_) {
+            plannedWakeUp_ = deadline;
+            earlier = true;
+        }
+    }
+    // Only a timer due before the planned wake-up shortens the timer thread's sleep
+    if (earlier) {
+        changed_.notify_one();
+    }
+}
+
+void TimerQueue::run(const std::stop_token stop) {
+    std::vector<TaskPool::Task*> due;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stop.stop_requested()) {
+        timers_.advance(Clock::now(), [&](TaskPool::Task* task) { due.push_back(task); });
+        if (!due.empty()) {
+            // Submitted outside the lock, so schedule() is never held up
+            lock.unlock();
+            for (TaskPool::Task* task : due) {
+                pool_.submit(*task);
+            }
+            due.clear();
+            lock.lock();
+            continue;
+        }
+
+        const std::optional<Clock::time_point> next = timers_.nextWakeUp();
+        plannedWakeUp_ = next.value_or(Clock::time_point::max());
+        const Clock::time_point planned = plannedWakeUp_;
+        const auto rescheduled = [&] { return plannedWakeUp_ != planned; };
+        if (next) {
+            changed_.wait_until(lock, stop, planned, rescheduled);
+        } else {
+            changed_.wait(lock, stop, rescheduled);
+        }
+    }
+}
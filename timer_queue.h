@@ -0,0 +1,42 @@
+/*
+    TimerQueue
+    ----------
+    One thread that submits tasks to a TaskPool once their deadline has passed, replacing
+    one sleeping thread per philosopher with a single hierarchical timer wheel (see
+    timer_wheel.h). The thread sleeps until the wheel's next wake-up, and is only woken early
+    by a new timer that is due before it.
+*/
+
+#pragma once
+
+#include "task_pool.h"
+#include "timer_wheel.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+class TimerQueue {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit TimerQueue(TaskPool& pool);
+    ~TimerQueue();
+
+    TimerQueue(const TimerQueue&) = delete;
+    TimerQueue& operator=(const TimerQueue&) = delete;
+
+    // Submits the task to the pool at the deadline
+    void schedule(Clock::time_point deadline, TaskPool::Task& task);
+
+private:
+    void run(std::stop_token stop);
+
+    TaskPool& pool_;
+    std::mutex mutex_;
+    std::condition_variable_any changed_;
+    TimerWheel<TaskPool::Task*> timers_;
+    Clock::time_point plannedWakeUp_ = Clock::time_point::max();  // When the timer thread wakes next
+    std::jthread thread_;
+};
@@ -0,0 +1,158 @@
+/*
+    TimerWheel
+    ----------
+    Hierarchical timer wheel: the time source of the pool and coroutine executors.
+
+    Time is cut into ticks of a fixed resolution. Level 0 has one slot per tick for the next
+    256 ticks; each higher level has 256 slots that each cover a whole rotation of the level
+    below, so four levels span 2^32 ticks (about five days at the default 100 us). A timer is
+    filed in the lowest level that reaches its expiry. Whenever a level's rotation wraps, the
+    coming slot of the level above is cascaded: its timers are re-filed, now landing at least
+    one level lower. Scheduling and firing are O(1), and a timer is cascaded at most once per
+    level, which bounds the amortized cost of a timer by the number of levels.
+
+    Timers fire at the first tick at or after their deadline, never before it. Not thread-safe.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+template <typename T>
+class TimerWheel {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr int SLOT_BITS = 8;
+    static constexpr int SLOTS = 1 << SLOT_BITS;
+    static constexpr int LEVELS = 4;
+    static constexpr std::chrono::nanoseconds DEFAULT_RESOLUTION = std::chrono::microseconds(100);
+
+    explicit TimerWheel(const Clock::time_point origin = Clock::now(),
+                        const std::chrono::nanoseconds resolution = DEFAULT_RESOLUTION)
+        : origin_(origin), resolution_(resolution) {}
+
+    // Files a timer that fires value at the first tick at or after the deadline
+    void schedule(const Clock::time_point deadline, T value) {
+        const auto sinceOrigin = std::max(deadline - origin_, Clock::duration::zero());
+        // Rounded up, so that a timer never fires early
+        std::uint64_t expiry = static_cast<std::uint64_t>((sinceOrigin + resolution_ - std::chrono::nanoseconds(1)) / resolution_);
+        // The current tick has already fired
+        expiry = std::max(expiry, currentTick_ + 1);
+        file(Entry{expiry, std::move(value)});
+        size_++;
+    }
+
+    /*
+        Function: advance
+        -----------------
+        Moves the wheel up to now and calls fire(value) for every timer that became due, in
+        tick order. fire() may schedule new timers; they never fire within the same call
+        unless their deadline has already passed.
+    */
+    template <typename Fire>
+    void advance(const Clock::time_point now, Fire&& fire) {
+        if (now < origin_) {
+            return;
+        }
+        const auto target = static_cast<std::uint64_t>((now - origin_) / resolution_);
+        if (size_ == 0) {
+            currentTick_ = std::max(currentTick_, target);  // Nothing to fire on the way
+            return;
+        }
+        while (currentTick_ < target) {
+            currentTick_++;
+            if ((currentTick_ & (SLOTS - 1)) == 0) {
+                cascade();
+            }
+
+            std::vector<Entry>& slot = levels_[0][currentTick_ & (SLOTS - 1)];
+            if (slot.empty()) {
+                continue;
+            }
+            firing_.swap(slot);
+            size_ -= firing_.size();
+            for (Entry& entry : firing_) {
+                fire(std::move(entry.value));
+            }
+            firing_.clear();
+            if (size_ == 0) {
+                currentTick_ = target;
+            }
+        }
+    }
+
+    /*
+        Function: nextWakeUp
+        --------------------
+        Earliest time at which advance() may have something to do: the next occupied tick of
+        the current level-0 rotation, or else the end of the rotation, when the next cascade
+        is due. Empty when no timer is scheduled.
+    */
+    std::optional<Clock::time_point> nextWakeUp() const {
+        if (size_ == 0) {
+            return std::nullopt;
+        }
+        std::uint64_t tick = currentTick_ + 1;
+        for (; (tick & (SLOTS - 1)) != 0; tick++) {
+            if (!levels_[0][tick & (SLOTS - 1)].empty()) {
+                break;
+            }
+        }
+        return origin_ + std::chrono::duration_cast<Clock::duration>(resolution_ * tick);
+    }
+
+    bool empty() const { return size_ == 0; }
+    std::size_t size() const { return size_; }
+
+private:
+    struct Entry {
+        std::uint64_t expiry;  // Tick at which the timer fires
+        T value;
+    };
+
+    // Puts the entry into the lowest level whose range reaches its expiry
+    void file(Entry entry) {
+        const std::uint64_t delta = entry.expiry - currentTick_;
+        int level = 0;
+        while (level < LEVELS - 1 && delta >= (std::uint64_t{1} << (SLOT_BITS * (level + 1)))) {
+            level++;
+        }
+        // Beyond the top level's range: park in its farthest slot and re-file on the cascade
+        std::uint64_t slotTick = entry.expiry;
+        if (delta >= (std::uint64_t{1} << (SLOT_BITS * LEVELS))) {
+            slotTick = currentTick_ + (std::uint64_t{1} << (SLOT_BITS * LEVELS)) - 1;
+        }
+        levels_[level][(slotTick >> (SLOT_BITS * level)) & (SLOTS - 1)].push_back(std::move(entry));
+    }
+
+    // Re-files the coming slot of every level whose lower rotation just wrapped
+    void cascade() {
+        for (int level = 1; level < LEVELS; level++) {
+            const std::size_t index = (currentTick_ >> (SLOT_BITS * level)) & (SLOTS - 1);
+            cascading_.swap(levels_[level][index]);
+            for (Entry& entry : cascading_) {
+                file(std::move(entry));
+            }
+            cascading_.clear();
+            if (index != 0) {
+                break;  // The level above has not wrapped
+            }
+        }
+    }
+
+    Clock::time_point origin_;
+    std::chrono::nanoseconds resolution_;
+    std::uint64_t currentTick_ = 0;  // Last tick that has fired
+    std::size_t size_ = 0;
+    std::array<std::array<std::vector<Entry>, SLOTS>, LEVELS> levels_;
+    std::vector<Entry> firing_;     // Scratch of advance(), kept to reuse its capacity
+    std::vector<Entry> cascading_;  // Scratch of cascade()
+};
@@ -0,0 +1,221 @@
+/*
+    trace-analyzer
+    --------------
+    Offline analysis of a binary event trace recorded with --trace-file.
+
+    Usage: trace-analyzer TRACE
+
+    The trace is streamed once, window by window (see TraceFileReader), keeping only a few
+    words of state per philosopher and per chopstick, so traces far larger than memory can
+    be analysed. The JSON report on stdout contains the distributions of hungry wait, think
+    and eat times, the fairness of the meals per philosopher, and the utilization of every
+    chopstick: the fraction of the traced time it was held.
+*/
+
+#include "json_writer.h"
+#include "metrics.h"
+#include "trace_file.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr std::int64_t NONE = -1;
+
+struct PhilosopherState {
+    std::int64_t thinkingSince = NONE;
+    std::int64_t hungrySince = NONE;
+    std::int64_t eatingSince = NONE;
+    int held = 0;                     // Chopsticks picked up since the last put-down
+    std::int32_t heldChopstick[2] = {};
+    std::int64_t heldSince[2] = {};
+    std::uint64_t meals = 0;
+};
+
+struct ChopstickState {
+    std::uint64_t heldNs = 0;
+    std::uint64_t holds = 0;
+};
+
+class TraceAnalysis {
+public:
+    explicit TraceAnalysis(const TraceHeader& header)
+        : philosophers_(static_cast<std::size_t>(std::max(header.numPhilosophers, 0))),
+          chopsticks_(static_cast<std::size_t>(std::max(header.numChopsticks, 0))) {}
+
+    void add(const TraceRecord& record) {
+        if (record.philosopher < 0) {
+            return;
+        }
+        const std::int64_t time = record.timeNs();
+        if (records_++ == 0) {
+            firstNs_ = time;
+        }
+        firstNs_ = std::min(firstNs_, time);
+        lastNs_ = std::max(lastNs_, time);
+
+        PhilosopherState& philosopher = philosopherAt(record.philosopher);
+        switch (record.event()) {
+            case Event::Thinking:
+                philosopher.thinkingSince = time;
+                break;
+            case Event::Thought:
+                recordSince(think_, philosopher.thinkingSince, time);
+                break;
+            case Event::Hungry:
+                philosopher.hungrySince = time;
+                break;
+            case Event::PickedLeft:
+            case Event::PickedRight:
+                if (philosopher.held < 2 && record.chopstick >= 0) {
+                    chopstickAt(record.chopstick);
+                    philosopher.heldChopstick[philosopher.held] = record.chopstick;
+                    philosopher.heldSince[philosopher.held] = time;
+                    philosopher.held++;
+                }
+                break;
+            case Event::Eating:
+                recordSince(hungryWait_, philosopher.hungrySince, time);
+                philosopher.eatingSince = time;
+                break;
+            case Event::Ate:
+                recordSince(eat_, philosopher.eatingSince, time);
+                philosopher.meals++;
+                break;
+            case Event::PutDown:  // Also after a backoff, with one chopstick held
+                releaseAll(philosopher, time);
+                break;
+        }
+    }
+
+    void report(JsonWriter& json, const std::string& path) {
+        // Chopsticks still held when the trace ends count as held until its last record
+        for (PhilosopherState& philosopher : philosophers_) {
+            releaseAll(philosopher, lastNs_);
+        }
+        const std::int64_t spanNs = records_ == 0 ? 0 : lastNs_ - firstNs_;
+
+        std::vector<std::uint64_t> meals;
+        meals.reserve(philosophers_.size());
+        for (const PhilosopherState& philosopher : philosophers_) {
+            meals.push_back(philosopher.meals);
+        }
+        std::vector<double> utilization;
+        utilization.reserve(chopsticks_.size());
+        for (const ChopstickState& chopstick : chopsticks_) {
+            utilization.push_back(spanNs == 0 ? 0.0 : static_cast<double>(chopstick.heldNs) / static_cast<double>(spanNs));
+        }
+
+        json.beginObject()
+            .field("trace", path)
+            .field("records", records_)
+            .field("philosophers", static_cast<std::uint64_t>(philosophers_.size()))
+            .field("chopsticks", static_cast<std::uint64_t>(chopsticks_.size()))
+            .field("span_s", static_cast<double>(spanNs) / 1e9)
+            .field("total_meals", std::accumulate(meals.begin(), meals.end(), std::uint64_t{0}));
+        json.key("hungry_wait_ns");
+        writeLatency(json, hungryWait_);
+        json.key("think_ns");
+        writeLatency(json, think_);
+        json.key("eat_ns");
+        writeLatency(json, eat_);
+
+        const auto [fewest, most] = std::minmax_element(meals.begin(), meals.end());
+        json.key("fairness").beginObject()
+            .field("jain_meals", jainFairness(meals))
+            .field("min_meals", meals.empty() ? 0 : *fewest)
+            .field("max_meals", meals.empty() ? 0 : *most)
+            .endObject();
+
+        const auto [idlest, busiest] = std::minmax_element(utilization.begin(), utilization.end());
+        json.key("chopstick_utilization").beginObject()
+            .field("mean", utilization.empty() ? 0.0 : std::accumulate(utilization.begin(), utilization.end(), 0.0) /
+                                                          static_cast<double>(utilization.size()))
+            .field("min", utilization.empty() ? 0.0 : *idlest)
+            .field("max", utilization.empty() ? 0.0 : *busiest)
+            .field("busiest", utilization.empty() ? -1 : static_cast<int>(busiest - utilization.begin()))
+            .endObject();
+
+        json.key("meals_per_philosopher").beginArray();
+        for (const std::uint64_t count : meals) {
+            json.value(count);
+        }
+        json.endArray();
+        json.key("utilization_per_chopstick").beginArray();
+        for (const double share : utilization) {
+            json.value(share);
+        }
+        json.endArray();
+        json.endObject();
+    }
+
+private:
+    // Records the time since a start mark, which is then consumed
+    static void recordSince(LatencyHistogram& histogram, std::int64_t& since, const std::int64_t time) {
+        if (since != NONE) {
+            histogram.record(static_cast<std::uint64_t>(std::max<std::int64_t>(time - since, 0)));
+            since = NONE;
+        }
+    }
+
+    void releaseAll(PhilosopherState& philosopher, const std::int64_t time) {
+        for (int i = 0; i < philosopher.held; i++) {
+            ChopstickState& chopstick = chopsticks_[philosopher.heldChopstick[i]];
+            chopstick.heldNs += static_cast<std::uint64_t>(std::max<std::int64_t>(time - philosopher.heldSince[i], 0));
+            chopstick.holds++;
+        }
+        philosopher.held = 0;
+    }
+
+    // The header's sizes are a hint: records beyond them grow the tables
+    PhilosopherState& philosopherAt(const std::int32_t id) {
+        if (static_cast<std::size_t>(id) >= philosophers_.size()) {
+            philosophers_.resize(static_cast<std::size_t>(id) + 1);
+        }
+        return philosophers_[id];
+    }
+
+    ChopstickState& chopstickAt(const std::int32_t id) {
+        if (static_cast<std::size_t>(id) >= chopsticks_.size()) {
+            chopsticks_.resize(static_cast<std::size_t>(id) + 1);
+        }
+        return chopsticks_[id];
+    }
+
+    std::vector<PhilosopherState> philosophers_;
+    std::vector<ChopstickState> chopsticks_;
+    LatencyHistogram hungryWait_;
+    LatencyHistogram think_;
+    LatencyHistogram eat_;
+    std::uint64_t records_ = 0;
+    std::int64_t firstNs_ = 0;
+    std::int64_t lastNs_ = 0;
+};
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc != 2) {
+        std::cerr << "Usage: " << argv[0] << " TRACE" << std::endl;
+        return 1;
+    }
+    try {
+        const TraceFileReader reader(argv[1]);
+        TraceAnalysis analysis(reader.header());
+        reader.forEach([&](const TraceRecord& record) { analysis.add(record); });
+
+        JsonWriter json(std::cout);
+        analysis.report(json, argv[1]);
+        std::cout << std::endl;
+    } catch (const std::runtime_error& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
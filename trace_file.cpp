@@ -0,0 +1,164 @@
+#include "trace_file.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr std::size_t INITIAL_BYTES = std::size_t{1} << 20;
+
+std::size_t pageSize() {
+    return static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+}
+
+std::size_t roundUp(const std::size_t value, const std::size_t multiple) {
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+TraceHeader& headerOf(unsigned char* mapping) {
+    return *reinterpret_cast<TraceHeader*>(mapping);
+}
+
+}  // namespace
+
+TraceFileWriter::TraceFileWriter(const std::string& path, const int numPhilosophers, const int numChopsticks)
+    : path_(path),
+      startNs_(std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::system_clock::now().time_since_epoch()).count()) {
+    fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd_ < 0) {
+        throw std::runtime_error("cannot create trace file '" + path + "': " + std::strerror(errno));
+    }
+    // Allocated up front rather than as a sparse file: a full disk then fails the
+    // allocation instead of raising SIGBUS on a write into the mapping
+    const int error = posix_fallocate(fd_, 0, static_cast<off_t>(INITIAL_BYTES));
+    void* mapping = error == 0 ? mmap(nullptr, INITIAL_BYTES, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0) : MAP_FAILED;
+    if (mapping == MAP_FAILED) {
+        ::close(fd_);
+        throw std::runtime_error("cannot map trace file '" + path + "'");
+    }
+    mapping_ = static_cast<unsigned char*>(mapping);
+    mappedBytes_ = INITIAL_BYTES;
+
+    TraceHeader& header = headerOf(mapping_);
+    std::memcpy(header.magic, TRACE_MAGIC, sizeof(TRACE_MAGIC));
+    header.version = TRACE_VERSION;
+    header.recordSize = sizeof(TraceRecord);
+    header.startNs = startNs_;
+    header.recordCount = 0;
+    header.numPhilosophers = numPhilosophers;
+    header.numChopsticks = numChopsticks;
+}
+
+TraceFileWriter::~TraceFileWriter() {
+    close();
+}
+
+bool TraceFileWriter::reserve(const std::size_t count) {
+    const std::size_t needed = sizeof(TraceHeader) + (records_ + count) * sizeof(TraceRecord);
+    if (needed <= mappedBytes_) {
+        return true;
+    }
+    const std::size_t grown = roundUp(std::max(mappedBytes_ * 2, needed), pageSize());
+    if (posix_fallocate(fd_, 0, static_cast<off_t>(grown)) != 0) {
+        return false;
+    }
+    void* mapping = mremap(mapping_, mappedBytes_, grown, MREMAP_MAYMOVE);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+    mapping_ = static_cast<unsigned char*>(mapping);
+    mappedBytes_ = grown;
+    return true;
+}
+
+void TraceFileWriter::write(const std::span<const LogRecord> records) {
+    if (failed_ || mapping_ == nullptr || records.empty()) {
+        return;
+    }
+    if (!reserve(records.size())) {
+        failed_ = true;
+        std::fprintf(stderr, "Warning: trace file '%s' cannot grow; tracing stopped after %llu records\n",
+                     path_.c_str(), static_cast<unsigned long long>(records_));
+        return;
+    }
+    unsigned char* cursor = mapping_ + sizeof(TraceHeader) + records_ * sizeof(TraceRecord);
+    for (const LogRecord& record : records) {
+        const TraceRecord traced = TraceRecord::make(std::max<std::int64_t>(record.timestampNs - startNs_, 0), record);
+        std::memcpy(cursor, &traced, sizeof(traced));
+        cursor += sizeof(traced);
+    }
+    records_ += records.size();
+    headerOf(mapping_).recordCount = records_;
+}
+
+void TraceFileWriter::close() {
+    if (fd_ < 0) {
+        return;
+    }
+    headerOf(mapping_).recordCount = records_;
+    munmap(mapping_, mappedBytes_);
+    mapping_ = nullptr;
+    if (ftruncate(fd_, static_cast<off_t>(sizeof(TraceHeader) + records_ * sizeof(TraceRecord))) != 0) {
+        std::fprintf(stderr, "Warning: cannot trim trace file '%s'\n", path_.c_str());
+    }
+    ::close(fd_);
+    fd_ = -1;
+}
+
+TraceFileReader::TraceFileReader(const std::string& path) {
+    fd_ = ::open(path.c_str(), O_RDONLY);
+    if (fd_ < 0) {
+        throw std::runtime_error("cannot open trace file '" + path + "': " + std::strerror(errno));
+    }
+    struct stat status{};
+    const bool complete = pread(fd_, &header_, sizeof(header_), 0) == static_cast<ssize_t>(sizeof(header_));
+    if (!complete || !hasTraceMagic(header_) || fstat(fd_, &status) != 0) {
+        ::close(fd_);
+        throw std::runtime_error("'" + path + "' is not a trace file");
+    }
+    if (header_.version != TRACE_VERSION || header_.recordSize != sizeof(TraceRecord)) {
+        ::close(fd_);
+        throw std::runtime_error("'" + path + "' has unsupported trace version " + std::to_string(header_.version));
+    }
+    // A trace cut short by a crash ends at its last record on disk
+    const auto available = (static_cast<std::uint64_t>(status.st_size) - sizeof(TraceHeader)) / sizeof(TraceRecord);
+    records_ = std::min<std::uint64_t>(header_.recordCount, available);
+}
+
+TraceFileReader::~TraceFileReader() {
+    ::close(fd_);
+}
+
+void TraceFileReader::forEach(const std::function<void(const TraceRecord&)>& visit, std::size_t windowBytes) const {
+    // Page-aligned windows; records are 16-byte aligned, so none straddles two windows
+    windowBytes = roundUp(std::max<std::size_t>(windowBytes, 1), pageSize());
+    const std::uint64_t end = sizeof(TraceHeader) + records_ * sizeof(TraceRecord);
+
+    for (std::uint64_t offset = 0; offset < end; offset += windowBytes) {
+        const auto length = static_cast<std::size_t>(std::min<std::uint64_t>(windowBytes, end - offset));
+        void* window = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd_, static_cast<off_t>(offset));
+        if (window == MAP_FAILED) {
+            throw std::runtime_error(std::string("cannot map trace window: ") + std::strerror(errno));
+        }
+        madvise(window, length, MADV_SEQUENTIAL);
+
+        const auto* bytes = static_cast<const unsigned char*>(window);
+        for (std::uint64_t position = std::max<std::uint64_t>(offset, sizeof(TraceHeader));
+             position < offset + length; position += sizeof(TraceRecord)) {
+            TraceRecord record;
+            std::memcpy(&record, bytes + (position - offset), sizeof(record));
+            visit(record);
+        }
+        munmap(window, length);
+    }
+}
@@ -0,0 +1,78 @@
+/*
+    TraceFile
+    ---------
+    Memory-mapped writer and streaming reader of binary event traces (see trace_format.h).
+
+    The writer runs on the logger's drainer thread: records are copied straight into a
+    shared mapping of the file, which grows by doubling, so the kernel writes them back in
+    the background and a batch costs no system call. The reader maps one window of the file
+    at a time and drops it once consumed, so a trace of any length is analysed in bounded
+    memory.
+*/
+
+#pragma once
+
+#include "logger.h"
+#include "trace_format.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string>
+
+class TraceFileWriter final : public TraceSink {
+public:
+    // Creates or truncates the file. Throws std::runtime_error if it cannot be created.
+    TraceFileWriter(const std::string& path, int numPhilosophers, int numChopsticks);
+    ~TraceFileWriter() override;
+
+    TraceFileWriter(const TraceFileWriter&) = delete;
+    TraceFileWriter& operator=(const TraceFileWriter&) = delete;
+
+    void write(std::span<const LogRecord> records) override;
+
+    // Trims the file to the records written and unmaps it
+    void close() override;
+
+private:
+    // Makes room for count more records; false once the file cannot grow any further
+    bool reserve(std::size_t count);
+
+    std::string path_;
+    int fd_ = -1;
+    unsigned char* mapping_ = nullptr;
+    std::size_t mappedBytes_ = 0;
+    std::uint64_t records_ = 0;
+    std::int64_t startNs_;
+    bool failed_ = false;  // Out of space: later records are dropped
+};
+
+class TraceFileReader {
+public:
+    // Opens the trace and validates its header. Throws std::runtime_error on failure.
+    explicit TraceFileReader(const std::string& path);
+    ~TraceFileReader();
+
+    TraceFileReader(const TraceFileReader&) = delete;
+    TraceFileReader& operator=(const TraceFileReader&) = delete;
+
+    const TraceHeader& header() const { return header_; }
+
+    // Complete records in the file
+    std::uint64_t size() const { return records_; }
+
+    /*
+        Function: forEach
+        -----------------
+        Streams every record, in file order, to visit. Only one window of windowBytes is
+        mapped at a time.
+    */
+    void forEach(const std::function<void(const TraceRecord&)>& visit,
+                 std::size_t windowBytes = std::size_t{64} << 20) const;
+
+private:
+    int fd_ = -1;
+    TraceHeader header_{};
+    std::uint64_t records_ = 0;
+};
@@ -0,0 +1,63 @@
+/*
+    TraceFormat
+    -----------
+    On-disk layout of a binary event trace (--trace-file), shared by the writer and the
+    trace-analyzer tool.
+
+    A trace is a 64-byte TraceHeader followed by recordCount fixed-width 16-byte
+    TraceRecords, in the byte order of the machine that wrote it. Records are grouped in
+    batches sorted by timestamp; the records of any one philosopher are always in order.
+    The writer keeps recordCount current after every batch, so the trace of a killed run
+    is readable up to its last complete batch.
+*/
+
+#pragma once
+
+#include "logger.h"
+
+#include <cstdint>
+#include <cstring>
+
+inline constexpr char TRACE_MAGIC[8] = {'D', 'P', 'T', 'R', 'A', 'C', 'E', '\0'};
+inline constexpr std::uint32_t TRACE_VERSION = 1;
+
+struct TraceHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t recordSize;      // sizeof(TraceRecord), checked by readers
+    std::int64_t startNs;          // Wall-clock time of record time 0, in ns since the epoch
+    std::uint64_t recordCount;     // Complete records following the header
+    std::int32_t numPhilosophers;
+    std::int32_t numChopsticks;
+    std::uint8_t reserved[24];
+};
+
+/*
+    Struct: TraceRecord
+    -------------------
+    One philosopher event. The time since TraceHeader::startNs and the event share one word
+    (56 bits of nanoseconds cover more than two years); the duration payload of LogRecord is
+    not stored, as readers derive it from the preceding event.
+*/
+struct TraceRecord {
+    static constexpr int EVENT_BITS = 8;
+
+    std::uint64_t timeAndEvent;
+    std::int32_t philosopher;
+    std::int32_t chopstick;  // Chopstick index, or -1 if not applicable
+
+    static TraceRecord make(const std::int64_t timeNs, const LogRecord& record) {
+        return TraceRecord{static_cast<std::uint64_t>(timeNs) << EVENT_BITS | static_cast<std::uint8_t>(record.event),
+                           record.philosopherID, record.chopstick};
+    }
+
+    std::int64_t timeNs() const { return static_cast<std::int64_t>(timeAndEvent >> EVENT_BITS); }
+    Event event() const { return static_cast<Event>(timeAndEvent & ((1u << EVENT_BITS) - 1)); }
+};
+
+static_assert(sizeof(TraceHeader) == 64, "TraceHeader is part of the file format");
+static_assert(sizeof(TraceRecord) == 16, "TraceRecord is part of the file format");
+
+inline bool hasTraceMagic(const TraceHeader& header) {
+    return std::memcmp(header.magic, TRACE_MAGIC, sizeof(TRACE_MAGIC)) == 0;
+}
@@ -0,0 +1,137 @@
+#include "watchdog.h"
+#include "duration.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace {
+
+// The fairness check waits until the philosophers ate this often on average, so that the
+// random spread of the first meals raises no alerts
+constexpr double WARM_UP_MEALS = 32.0;
+
+std::chrono::nanoseconds pollInterval(const std::chrono::milliseconds waitSlo) {
+    if (waitSlo.count() == 0) {
+        return std::chrono::milliseconds(100);
+    }
+    return std::clamp<std::chrono::nanoseconds>(waitSlo / 4, std::chrono::milliseconds(1),
+                                                std::chrono::milliseconds(100));
+}
+
+double toMs(const std::uint64_t ns) {
+    return static_cast<double>(ns) / 1e6;
+}
+
+}  // namespace
+
+Watchdog::Watchdog(const DiningTable& table, const std::chrono::milliseconds waitSlo, const double fairnessThreshold)
+    : table_(table),
+      waitSlo_(waitSlo),
+      fairnessThreshold_(fairnessThreshold),
+      flaggedWait_(table.numPhilosophers, 0),
+      belowFairShare_(table.numPhilosophers, false),
+      sloViolations_(table.numPhilosophers, 0),
+      fairnessAlerts_(table.numPhilosophers, 0) {
+    if (enabled()) {
+        thread_ = std::jthread([this](const std::stop_token stop) { run(stop); });
+    }
+}
+
+Watchdog::~Watchdog() {
+    stop();
+}
+
+void Watchdog::stop() {
+    if (thread_.joinable()) {
+        thread_.request_stop();
+        thread_.join();
+    }
+}
+
+void Watchdog::printSummary(std::FILE* out) const {
+    if (!enabled()) {
+        return;
+    }
+    const auto countFlagged = [](const std::vector<std::uint64_t>& alerts) {
+        return std::count_if(alerts.begin(), alerts.end(), [](const std::uint64_t count) { return count > 0; });
+    };
+    std::fprintf(out, "Watchdog: %llu waits over the %lld ms SLO by %ld philosophers (longest seen: %.1f ms), "
+                      "%llu fairness alerts for %ld philosophers\n",
+                 static_cast<unsigned long long>(std::accumulate(sloViolations_.begin(), sloViolations_.end(), std::uint64_t{0})),
+                 static_cast<long long>(waitSlo_.count()), static_cast<long>(countFlagged(sloViolations_)),
+                 toMs(longestWaitNs_),
+                 static_cast<unsigned long long>(std::accumulate(fairnessAlerts_.begin(), fairnessAlerts_.end(), std::uint64_t{0})),
+                 static_cast<long>(countFlagged(fairnessAlerts_)));
+}
+
+void Watchdog::run(const std::stop_token stop) {
+    const std::chrono::nanoseconds interval = pollInterval(waitSlo_);
+    while (!stop.stop_requested()) {
+        sleepFor(interval, stop);
+        check();  // Also once more when stopped, for the waits still open at the end
+    }
+}
+
+void Watchdog::check() {
+    const std::int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    const auto sloNs = static_cast<std::uint64_t>(std::chrono::nanoseconds(waitSlo_).count());
+
+    int overSlo = 0;
+    int longestID = -1;
+    std::uint64_t longestNs = 0;
+    for (int i = 0; i < table_.numPhilosophers; i++) {
+        const std::int64_t since = table_.stats[i].hungrySinceNs.load(std::memory_order_relaxed);
+        if (since == 0 || since > now) {
+            continue;
+        }
+        const auto waitNs = static_cast<std::uint64_t>(now - since);
+        longestWaitNs_ = std::max(longestWaitNs_, waitNs);
+        if (sloNs == 0 || waitNs <= sloNs || flaggedWait_[i] == since) {
+            continue;
+        }
+        flaggedWait_[i] = since;
+        sloViolations_[i]++;
+        overSlo++;
+        if (waitNs > longestNs) {
+            longestNs = waitNs;
+            longestID = i;
+        }
+    }
+    if (overSlo > 0) {
+        std::fprintf(stderr, "Watchdog: %d philosopher%s hungry beyond the %lld ms wait SLO (longest: philosopher %d, %.1f ms)\n",
+                     overSlo, overSlo == 1 ? "" : "s", static_cast<long long>(waitSlo_.count()), longestID, toMs(longestNs));
+    }
+
+    if (fairnessThreshold_ <= 0.0) {
+        return;
+    }
+    std::uint64_t totalMeals = 0;
+    for (int i = 0; i < table_.numPhilosophers; i++) {
+        totalMeals += table_.stats[i].meals.load(std::memory_order_relaxed);
+    }
+    const double mean = static_cast<double>(totalMeals) / table_.numPhilosophers;
+    if (mean < WARM_UP_MEALS) {
+        return;
+    }
+    int belowShare = 0;
+    int fewestID = -1;
+    std::uint64_t fewest = 0;
+    for (int i = 0; i < table_.numPhilosophers; i++) {
+        const std::uint64_t meals = table_.stats[i].meals.load(std::memory_order_relaxed);
+        const bool below = static_cast<double>(meals) < fairnessThreshold_ * mean;
+        if (below && !belowFairShare_[i]) {
+            fairnessAlerts_[i]++;
+            belowShare++;
+            if (fewestID == -1 || meals < fewest) {
+                fewest = meals;
+                fewestID = i;
+            }
+        }
+        belowFairShare_[i] = below;
+    }
+    if (belowShare > 0) {
+        std::fprintf(stderr, "Watchdog: %d philosopher%s below %.0f%% of the mean meals (fewest: philosopher %d, %llu of %.1f)\n",
+                     belowShare, belowShare == 1 ? "" : "s", fairnessThreshold_ * 100.0, fewestID, static_cast<unsigned long long>(fewest), mean);
+    }
+}
@@ -0,0 +1,71 @@
+/*
+    Watchdog
+    --------
+    Background starvation detector. None of the strategies bounds how long a philosopher may
+    stay hungry, so the watchdog checks two service levels while the table runs:
+    - wait SLO: a philosopher hungry for longer than the SLO is flagged, once per wait. Every
+      philosopher publishes the start of its current wait in PhilosopherStats::hungrySinceNs,
+      so waits that never end, which the latency histogram cannot show, are caught as well.
+    - fairness: a philosopher whose meals fall below threshold x the mean is flagged, once
+      each time it drops below. The check starts once the mean reaches a few meals.
+
+    Like the StatsReporter it only reads relaxed atomics and never synchronizes with the
+    philosophers. It polls at a quarter of the SLO (between 1 and 100 ms), so a wait is
+    flagged at most a quarter SLO late; waits just over the SLO that end in between may be
+    missed. New alerts are summarized on stderr once per poll.
+*/
+
+#pragma once
+
+#include "philosopher.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+class Watchdog {
+public:
+    // Does nothing if both the SLO and the threshold are zero
+    Watchdog(const DiningTable& table, std::chrono::milliseconds waitSlo, double fairnessThreshold);
+    ~Watchdog();
+
+    Watchdog(const Watchdog&) = delete;
+    Watchdog& operator=(const Watchdog&) = delete;
+
+    bool enabled() const { return waitSlo_.count() > 0 || fairnessThreshold_ > 0.0; }
+
+    // Runs a last check and stops the watchdog thread; the results below are final afterwards
+    void stop();
+
+    std::chrono::milliseconds waitSlo() const { return waitSlo_; }
+    double fairnessThreshold() const { return fairnessThreshold_; }
+
+    // Waits that exceeded the SLO, per philosopher
+    const std::vector<std::uint64_t>& sloViolations() const { return sloViolations_; }
+
+    // Times each philosopher fell below the fair share
+    const std::vector<std::uint64_t>& fairnessAlerts() const { return fairnessAlerts_; }
+
+    // Longest wait seen by the watchdog, including waits still open at the last check
+    std::uint64_t longestWaitNs() const { return longestWaitNs_; }
+
+    // One-line summary of the alerts
+    void printSummary(std::FILE* out) const;
+
+private:
+    void run(std::stop_token stop);
+    void check();
+
+    const DiningTable& table_;
+    const std::chrono::milliseconds waitSlo_;
+    const double fairnessThreshold_;
+    std::vector<std::int64_t> flaggedWait_;  // hungrySinceNs of the wait last flagged
+    std::vector<bool> belowFairShare_;
+    std::vector<std::uint64_t> sloViolations_;
+    std::vector<std::uint64_t> fairnessAlerts_;
+    std::uint64_t longestWaitNs_ = 0;
+    std::jthread thread_;
+};